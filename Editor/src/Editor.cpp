@@ -7,6 +7,7 @@
 
 #include "Platform/FileDialog.h"
 #include "Project/Project.h"
+#include "Vulkan/PipelineCache.h"
 
 namespace Engine
 {
@@ -15,6 +16,8 @@ namespace Engine
 		if (const auto path = spec.args[1]; std::filesystem::exists(path))
 		{
 			Project::Load(path);
+
+			GetRenderContext().GetDevice().GetPipelineCache().Load(Project::GetPipelineCachePath());
 		}
 		else
 		{
@@ -43,6 +46,7 @@ namespace Engine
 		toolbar = std::make_unique<Toolbar>();
 		viewportDragDrop = std::make_unique<ViewportDragDrop>();
 		entityGizmo = std::make_unique<EntityGizmo>(*camera);
+		renderGraphViewer = std::make_unique<RenderGraphViewer>(GetRenderer());
 
 		sceneHierarchy->OnSelectEntity([&](auto entity) {
 			entityInspector->SetEntity(entity);
@@ -130,6 +134,7 @@ namespace Engine
 	Editor::~Editor()
 	{
 		GetRenderContext().GetDevice().WaitIdle();
+		GetRenderContext().GetDevice().GetPipelineCache().Save();
 	}
 
 	void Editor::OnUpdate(float timestep)
@@ -169,6 +174,7 @@ namespace Engine
 		entityInspector->Draw(scene);
 		contentBrowser->Draw(scene);
 		entityGizmo->Draw(scene);
+		renderGraphViewer->Draw(scene);
     }
 
 	void Editor::OnWindowResize(int width, int height)
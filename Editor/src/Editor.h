@@ -10,6 +10,7 @@
 #include "Widget/ViewportDragDrop.h"
 #include "Widget/EntityGizmo.h"
 #include "Widget/Toolbar.h"
+#include "Widget/RenderGraphViewer.h"
 
 #include "EditorCamera.h"
 #include "Util/FileWatcher.h"
@@ -45,6 +46,7 @@ namespace Engine
         std::unique_ptr<ViewportDragDrop> viewportDragDrop;
         std::unique_ptr<EntityGizmo> entityGizmo;
         std::unique_ptr<Toolbar> toolbar;
+        std::unique_ptr<RenderGraphViewer> renderGraphViewer;
 
 
 
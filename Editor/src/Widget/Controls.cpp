@@ -121,6 +121,7 @@ namespace Controls
 	void Component(Engine::Component::MeshRender* component)
 	{
 		ImGui::TextDisabled("%s", component->mesh->GetId().ToString().c_str());
+		ImGui::Checkbox("Cast Shadows", &component->castShadows);
 	}
 
 	template<>
@@ -63,7 +63,15 @@ void EntityInspector::Draw(Engine::Scene& scene)
 
 	if (auto meshRender = scene.TryGetComponent<Engine::Component::MeshRender>(entity))
 	{
+		const auto castShadows = meshRender->castShadows;
+
 		ComponentControlNode<Engine::Component::MeshRender>(scene, "Mesh Render", meshRender);
+
+		// Controls write straight into the component, the renderer only picks up changes it is told about
+		if (scene.HasComponent<Engine::Component::MeshRender>(entity) && meshRender->castShadows != castShadows)
+		{
+			scene.PatchComponent<Engine::Component::MeshRender>(entity);
+		}
 	}
 
 	if (auto directionalLight = scene.TryGetComponent<Engine::Component::DirectionalLight>(entity))
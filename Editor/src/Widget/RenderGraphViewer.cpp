@@ -0,0 +1,160 @@
+#include "RenderGraphViewer.h"
+
+#include <Project/Project.h>
+
+#include <imgui.h>
+
+RenderGraphViewer::RenderGraphViewer(Engine::Renderer& renderer) : renderer(renderer)
+{
+}
+
+void RenderGraphViewer::Draw(Engine::Scene& scene)
+{
+	if (!freeze)
+	{
+		snapshot = renderer.GetGraphSnapshot();
+		memory = renderer.GetTransientMemoryStats();
+	}
+
+	ImGui::Begin("Render Graph");
+
+	ImGui::Checkbox("Freeze", &freeze);
+	ImGui::SameLine();
+
+	if (ImGui::Button("Export"))
+	{
+		Export();
+	}
+
+	ImGui::Text("Record time: %.3f ms", std::chrono::duration<double, std::milli>(snapshot.GetRecordTime()).count());
+
+	constexpr double megabyte = 1024.0 * 1024.0;
+
+	ImGui::Text("Transient memory: %.1f MB live, %.1f MB pooled, %.1f MB saved by aliasing",
+		memory.liveBytes / megabyte, memory.pooledBytes / megabyte, memory.GetSavedBytes() / megabyte);
+
+	if (ImGui::CollapsingHeader("Passes", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		PassTable();
+	}
+
+	if (ImGui::CollapsingHeader("Resources", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ResourceTable();
+	}
+
+	ImGui::End();
+}
+
+void RenderGraphViewer::PassTable()
+{
+	if (!ImGui::BeginTable("Passes", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		return;
+	}
+
+	ImGui::TableSetupColumn("Order");
+	ImGui::TableSetupColumn("Name");
+	ImGui::TableSetupColumn("Record (ms)");
+	ImGui::TableSetupColumn("Barriers");
+	ImGui::TableSetupColumn("Resources");
+	ImGui::TableHeadersRow();
+
+	for (const auto& pass : snapshot.passes)
+	{
+		ImGui::TableNextRow();
+
+		if (pass.IsCulled())
+		{
+			ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
+		}
+
+		ImGui::TableNextColumn();
+
+		if (pass.IsCulled())
+		{
+			ImGui::TextUnformatted("culled");
+		}
+		else
+		{
+			ImGui::Text("%u", pass.order);
+		}
+
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(pass.name.c_str());
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", std::chrono::duration<double, std::milli>(pass.recordTime).count());
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", pass.barriers);
+
+		ImGui::TableNextColumn();
+
+		for (const auto& access : pass.accesses)
+		{
+			const auto& resource = snapshot.resources[access.resource];
+
+			ImGui::Text("%s %s", access.write ? "W" : "R", resource.name.c_str());
+		}
+
+		if (pass.IsCulled())
+		{
+			ImGui::PopStyleColor();
+		}
+	}
+
+	ImGui::EndTable();
+}
+
+void RenderGraphViewer::ResourceTable()
+{
+	if (!ImGui::BeginTable("Resources", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		return;
+	}
+
+	ImGui::TableSetupColumn("Name");
+	ImGui::TableSetupColumn("Description");
+	ImGui::TableSetupColumn("Type");
+	ImGui::TableSetupColumn("Lifetime");
+	ImGui::TableHeadersRow();
+
+	for (const auto& resource : snapshot.resources)
+	{
+		ImGui::TableNextRow();
+
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(resource.name.c_str());
+
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(resource.description.c_str());
+
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(resource.imported ? "Imported" : "Transient");
+
+		ImGui::TableNextColumn();
+
+		if (resource.first == Engine::RenderGraphSnapshot::none)
+		{
+			ImGui::TextDisabled("unused");
+		}
+		else
+		{
+			ImGui::Text("%u - %u", resource.first, resource.last);
+		}
+	}
+
+	ImGui::EndTable();
+}
+
+void RenderGraphViewer::Export()
+{
+	const auto directory = Engine::Project::GetProjectDirectory();
+
+	std::ofstream dot{ directory / "rendergraph.dot" };
+	Engine::WriteDot(snapshot, dot);
+
+	std::ofstream json{ directory / "rendergraph.json" };
+	Engine::WriteJson(snapshot, json);
+}
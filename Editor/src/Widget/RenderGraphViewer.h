@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Widget.h"
+
+#include <Rendering/Renderer.h>
+
+class RenderGraphViewer : public Widget
+{
+public:
+	explicit RenderGraphViewer(Engine::Renderer& renderer);
+
+	void Draw(Engine::Scene& scene) override;
+
+private:
+	void PassTable();
+	void ResourceTable();
+
+	void Export();
+
+	Engine::Renderer& renderer;
+	Engine::RenderGraphSnapshot snapshot;
+	Engine::VulkanRenderGraphAllocatorStats memory;
+
+	// Keeps the last snapshot on screen instead of taking a new one every frame
+	bool freeze = false;
+};
@@ -4,6 +4,7 @@
 
 namespace Engine
 {
+    // Safe to use from several threads, a resource missing from the cache is created while holding the lock
     template<typename T>
     class Cache
     {
@@ -15,6 +16,8 @@ namespace Engine
 
             Hash(hash, args...);
 
+            std::lock_guard lock{ mutex };
+
             auto it = resources.find(hash);
 
             if (it != resources.end())
@@ -31,10 +34,13 @@ namespace Engine
 
         void Clear()
         {
+            std::lock_guard lock{ mutex };
+
             resources.clear();
         }
 
     private:
         std::unordered_map<std::size_t, std::unique_ptr<T>> resources;
+        std::mutex mutex;
     };
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "FreeListAllocator.h"
+
+namespace Engine
+{
+    FreeListAllocator::FreeListAllocator(uint32_t size) : size(size), freeSize(size)
+    {
+        if (size > 0)
+        {
+            ranges.emplace(0, size);
+        }
+    }
+
+    std::optional<uint32_t> FreeListAllocator::Allocate(uint32_t size, uint32_t alignment)
+    {
+        if (size == 0)
+        {
+            return std::nullopt;
+        }
+
+        for (auto it = ranges.begin(); it != ranges.end(); ++it)
+        {
+            const auto [offset, rangeSize] = *it;
+            const auto aligned = (offset + alignment - 1) / alignment * alignment;
+            const auto end = static_cast<uint64_t>(offset) + rangeSize;
+
+            if (aligned + static_cast<uint64_t>(size) > end)
+            {
+                continue;
+            }
+
+            ranges.erase(it);
+
+            // The padding in front and whatever is left behind stay free
+            if (aligned > offset)
+            {
+                ranges.emplace(offset, aligned - offset);
+            }
+
+            if (aligned + size < end)
+            {
+                ranges.emplace(aligned + size, static_cast<uint32_t>(end - aligned - size));
+            }
+
+            freeSize -= size;
+
+            return aligned;
+        }
+
+        return std::nullopt;
+    }
+
+    void FreeListAllocator::Free(uint32_t offset, uint32_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+
+        assert(static_cast<uint64_t>(offset) + size <= this->size);
+
+        freeSize += size;
+
+        auto next = ranges.lower_bound(offset);
+
+        if (next != ranges.end() && offset + size == next->first)
+        {
+            size += next->second;
+            next = ranges.erase(next);
+        }
+
+        if (next != ranges.begin())
+        {
+            auto previous = std::prev(next);
+
+            if (previous->first + previous->second == offset)
+            {
+                previous->second += size;
+                return;
+            }
+        }
+
+        ranges.emplace_hint(next, offset, size);
+    }
+
+    uint32_t FreeListAllocator::GetSize() const
+    {
+        return size;
+    }
+
+    uint32_t FreeListAllocator::GetFreeSize() const
+    {
+        return freeSize;
+    }
+
+    size_t FreeListAllocator::GetFreeRangeCount() const
+    {
+        return ranges.size();
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Engine
+{
+    // First fit allocator handing out ranges of a fixed size space it doesn't own, like the bytes of a buffer.
+    // Freed ranges are merged with their free neighbours, so the space doesn't fragment into unusable pieces.
+    class FreeListAllocator
+    {
+    public:
+        explicit FreeListAllocator(uint32_t size);
+
+        // Offset of a range of the given size, aligned to alignment, or nothing if no free range fits it
+        std::optional<uint32_t> Allocate(uint32_t size, uint32_t alignment = 1);
+        void Free(uint32_t offset, uint32_t size);
+
+        [[nodiscard]] uint32_t GetSize() const;
+        [[nodiscard]] uint32_t GetFreeSize() const;
+        [[nodiscard]] size_t GetFreeRangeCount() const;
+
+    private:
+        // Free ranges by their offset
+        std::map<uint32_t, uint32_t> ranges;
+
+        uint32_t size;
+        uint32_t freeSize;
+    };
+}
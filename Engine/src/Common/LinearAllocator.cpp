@@ -0,0 +1,78 @@
+#include "LinearAllocator.h"
+
+namespace Engine
+{
+    LinearAllocator::LinearAllocator(size_t blockSize, std::pmr::memory_resource* upstream) : upstream(upstream), blockSize(blockSize)
+    {
+    }
+
+    LinearAllocator::~LinearAllocator()
+    {
+        for (const auto& block : blocks)
+        {
+            upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+        }
+    }
+
+    void LinearAllocator::Reset()
+    {
+        current = 0;
+        offset = 0;
+        used = 0;
+    }
+
+    size_t LinearAllocator::GetUsedBytes() const
+    {
+        return used;
+    }
+
+    size_t LinearAllocator::GetCapacity() const
+    {
+        size_t capacity{ 0 };
+
+        for (const auto& block : blocks)
+        {
+            capacity += block.size;
+        }
+
+        return capacity;
+    }
+
+    void* LinearAllocator::do_allocate(size_t bytes, size_t alignment)
+    {
+        for (; current < blocks.size(); current++, offset = 0)
+        {
+            auto& block = blocks[current];
+
+            void* pointer = block.data + offset;
+            size_t space = block.size - offset;
+
+            if (std::align(alignment, bytes, pointer, space))
+            {
+                offset = block.size - space + bytes;
+                used += bytes;
+
+                return pointer;
+            }
+        }
+
+        auto size = std::max(blockSize, bytes + alignment);
+
+        blocks.push_back({ static_cast<std::byte*>(upstream->allocate(size, alignof(std::max_align_t))), size });
+
+        current = blocks.size() - 1;
+        offset = 0;
+
+        return do_allocate(bytes, alignment);
+    }
+
+    void LinearAllocator::do_deallocate(void* pointer, size_t bytes, size_t alignment)
+    {
+        // Memory is only given back all at once on Reset
+    }
+
+    bool LinearAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+}
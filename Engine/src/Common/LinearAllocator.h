@@ -0,0 +1,42 @@
+#pragma once
+
+namespace Engine
+{
+    // Bump allocator that keeps its blocks when reset, so a workload that repeats every frame
+    // stops touching the heap once the blocks have grown to fit it. Blocks come from the upstream resource.
+    class LinearAllocator final : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        explicit LinearAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+        ~LinearAllocator() override;
+
+        LinearAllocator(const LinearAllocator&) = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+        void Reset();
+
+        [[nodiscard]] size_t GetUsedBytes() const;
+        [[nodiscard]] size_t GetCapacity() const;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        struct Block
+        {
+            std::byte* data{ nullptr };
+            size_t size{ 0 };
+        };
+
+        std::pmr::memory_resource* upstream;
+        std::vector<Block> blocks;
+
+        size_t blockSize;
+        size_t current{ 0 };
+        size_t offset{ 0 };
+        size_t used{ 0 };
+    };
+}
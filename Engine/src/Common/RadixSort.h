@@ -0,0 +1,53 @@
+#pragma once
+
+namespace Engine
+{
+    // Stable LSD radix sort on a 64 bit key, a byte per pass. Passes where every key has the same byte are skipped,
+    // so keys that only use a few of their bits stay cheap. Scratch only provides storage and is left unspecified.
+    template<typename T, typename Key>
+    void RadixSort(std::vector<T>& items, std::vector<T>& scratch, Key key)
+    {
+        constexpr uint32_t radix = 256;
+        constexpr uint32_t passes = sizeof(uint64_t);
+
+        std::array<std::array<uint32_t, radix>, passes> histograms{};
+
+        for (const auto& item : items)
+        {
+            const uint64_t value = key(item);
+
+            for (uint32_t pass = 0; pass < passes; pass++)
+            {
+                histograms[pass][(value >> (pass * 8)) & (radix - 1)]++;
+            }
+        }
+
+        scratch.resize(items.size());
+
+        for (uint32_t pass = 0; pass < passes; pass++)
+        {
+            auto& histogram = histograms[pass];
+
+            if (std::ranges::any_of(histogram, [&](auto count) { return count == items.size(); }))
+            {
+                continue;
+            }
+
+            uint32_t offset = 0;
+
+            for (auto& count : histogram)
+            {
+                offset += std::exchange(count, offset);
+            }
+
+            for (auto& item : items)
+            {
+                const uint64_t value = key(item);
+
+                scratch[histogram[(value >> (pass * 8)) & (radix - 1)]++] = std::move(item);
+            }
+
+            std::swap(items, scratch);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "ThreadPool.h"
+
+namespace Engine
+{
+    thread_local uint32_t threadIndex{ 0 };
+
+    ThreadPool::ThreadPool(uint32_t workers)
+    {
+        threads.reserve(workers);
+
+        for (uint32_t index = 1; index <= workers; index++)
+        {
+            threads.emplace_back(&ThreadPool::Work, this, index);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock{ mutex };
+            stopping = true;
+        }
+
+        available.notify_all();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        if (threads.empty())
+        {
+            task();
+            return;
+        }
+
+        {
+            std::lock_guard lock{ mutex };
+
+            tasks.push(std::move(task));
+            pending++;
+        }
+
+        available.notify_one();
+    }
+
+    void ThreadPool::Wait()
+    {
+        std::unique_lock lock{ mutex };
+
+        finished.wait(lock, [this] { return pending == 0; });
+
+        if (exception)
+        {
+            auto rethrown = exception;
+            exception = nullptr;
+
+            std::rethrow_exception(rethrown);
+        }
+    }
+
+    uint32_t ThreadPool::GetThreadCount() const
+    {
+        return static_cast<uint32_t>(threads.size()) + 1;
+    }
+
+    uint32_t ThreadPool::GetThreadIndex()
+    {
+        return threadIndex;
+    }
+
+    uint32_t ThreadPool::GetDefaultWorkerCount()
+    {
+        const auto hardware = std::thread::hardware_concurrency();
+
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    void ThreadPool::Work(uint32_t index)
+    {
+        threadIndex = index;
+
+        while (true)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock lock{ mutex };
+
+                available.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+                if (tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                std::lock_guard lock{ mutex };
+
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+
+            {
+                std::lock_guard lock{ mutex };
+                pending--;
+            }
+
+            finished.notify_all();
+        }
+    }
+}
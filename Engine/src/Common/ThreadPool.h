@@ -0,0 +1,43 @@
+#pragma once
+
+namespace Engine
+{
+    // Fixed set of worker threads running submitted tasks in no particular order. Each thread has a stable index,
+    // 0 for any thread outside the pool and 1 to GetThreadCount() - 1 for the workers, so per-thread resources
+    // can be looked up without locking.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(uint32_t workers = GetDefaultWorkerCount());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Runs the task inline when the pool has no workers
+        void Submit(std::function<void()> task);
+
+        // Blocks until every submitted task finished, rethrowing the first exception one of them threw
+        void Wait();
+
+        [[nodiscard]] uint32_t GetThreadCount() const;
+
+        [[nodiscard]] static uint32_t GetThreadIndex();
+        [[nodiscard]] static uint32_t GetDefaultWorkerCount();
+
+    private:
+        void Work(uint32_t index);
+
+        std::vector<std::thread> threads;
+        std::queue<std::function<void()>> tasks;
+
+        std::mutex mutex;
+        std::condition_variable available;
+        std::condition_variable finished;
+
+        uint32_t pending{ 0 };
+        bool stopping{ false };
+
+        std::exception_ptr exception;
+    };
+}
@@ -129,6 +129,8 @@ namespace Engine {
 	void Application::SetScene(Scene& scene)
 	{
 		*this->scene = scene;
+
+		renderer->InvalidateGraphs();
 	}
 
 	Scene& Application::GetScene()
@@ -146,6 +148,11 @@ namespace Engine {
 		return *renderContext;
 	}
 
+	Renderer& Application::GetRenderer()
+	{
+		return *renderer;
+	}
+
 	void Application::StartScene()
 	{
 		scene->Resume();
@@ -61,6 +61,8 @@ namespace Engine {
 
 		RenderContext& GetRenderContext();
 
+		Renderer& GetRenderer();
+
 		void SetCameraAspectRatio(Entity::Id entity);
 	private:
 		std::unique_ptr<Window> window;
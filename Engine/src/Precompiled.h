@@ -2,13 +2,18 @@
 
 #include <typeindex>
 #include <any>
+#include <optional>
 #include <type_traits>
 #include <memory>
+#include <memory_resource>
 #include <algorithm>
 #include <functional>
+#include <utility>
 
 #include <atomic>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include <unordered_map>
 #include <map>
@@ -33,6 +38,7 @@
 #include <cstdint>
 #include <chrono>
 #include <cmath>
+#include <bit>
 #include <cstring>
 
 #define GLM_ENABLE_EXPERIMENTAL
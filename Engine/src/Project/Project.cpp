@@ -54,4 +54,9 @@ namespace Engine
 	{
 		return GetResourceDirectory() / activeProject->config.resourceRegistry;
 	}
+
+	std::filesystem::path Project::GetPipelineCachePath()
+	{
+		return GetProjectDirectory() / "pipelines.cache";
+	}
 };
\ No newline at end of file
@@ -18,6 +18,7 @@ namespace Engine
 		static std::filesystem::path GetResourceDirectory();
 		static std::filesystem::path GetImportsDirectory();
 		static std::filesystem::path GetResourceRegistryPath();
+		static std::filesystem::path GetPipelineCachePath();
 
 	private:
 		std::filesystem::path directory;
@@ -0,0 +1,158 @@
+#include "Frustum.h"
+
+#include "Mesh.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define ENGINE_FRUSTUM_SSE
+#endif
+
+namespace Engine
+{
+	void CullingBounds::Clear()
+	{
+		centerX.clear();
+		centerY.clear();
+		centerZ.clear();
+
+		extentX.clear();
+		extentY.clear();
+		extentZ.clear();
+	}
+
+	void CullingBounds::Add(const AABB& bounds)
+	{
+		const auto center = bounds.GetCenter();
+		const auto extents = bounds.GetExtents();
+
+		centerX.push_back(center.x);
+		centerY.push_back(center.y);
+		centerZ.push_back(center.z);
+
+		extentX.push_back(extents.x);
+		extentY.push_back(extents.y);
+		extentZ.push_back(extents.z);
+	}
+
+	void CullingBounds::Set(uint32_t index, const AABB& bounds)
+	{
+		const auto center = bounds.GetCenter();
+		const auto extents = bounds.GetExtents();
+
+		centerX[index] = center.x;
+		centerY[index] = center.y;
+		centerZ[index] = center.z;
+
+		extentX[index] = extents.x;
+		extentY[index] = extents.y;
+		extentZ[index] = extents.z;
+	}
+
+	void CullingBounds::Remove(uint32_t index)
+	{
+		for (auto* component : { &centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ })
+		{
+			(*component)[index] = component->back();
+			component->pop_back();
+		}
+	}
+
+	glm::vec3 CullingBounds::GetCenter(uint32_t index) const
+	{
+		return { centerX[index], centerY[index], centerZ[index] };
+	}
+
+	uint32_t CullingBounds::GetCount() const
+	{
+		return static_cast<uint32_t>(centerX.size());
+	}
+
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		const auto row = [&](int index) {
+			return glm::vec4{ viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index] };
+		};
+
+		planes[0] = row(3) + row(0);
+		planes[1] = row(3) - row(0);
+		planes[2] = row(3) + row(1);
+		planes[3] = row(3) - row(1);
+		planes[4] = row(2);
+		planes[5] = row(3) - row(2);
+	}
+
+	bool Frustum::Intersects(const AABB& bounds) const
+	{
+		return Intersects(bounds.GetCenter(), bounds.GetExtents());
+	}
+
+	// A box is outside once its center is further behind a plane than its extents reach towards it
+	bool Frustum::Intersects(glm::vec3 center, glm::vec3 extents) const
+	{
+		for (const auto& plane : planes)
+		{
+			const glm::vec3 normal{ plane };
+
+			if (glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extents) < 0.f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void Frustum::Cull(const CullingBounds& bounds, std::vector<uint8_t>& visible) const
+	{
+		const auto count = bounds.GetCount();
+
+		visible.resize(count);
+
+		uint32_t index = 0;
+
+#ifdef ENGINE_FRUSTUM_SSE
+		for (; index + 4 <= count; index += 4)
+		{
+			const auto centerX = _mm_loadu_ps(&bounds.centerX[index]);
+			const auto centerY = _mm_loadu_ps(&bounds.centerY[index]);
+			const auto centerZ = _mm_loadu_ps(&bounds.centerZ[index]);
+
+			const auto extentX = _mm_loadu_ps(&bounds.extentX[index]);
+			const auto extentY = _mm_loadu_ps(&bounds.extentY[index]);
+			const auto extentZ = _mm_loadu_ps(&bounds.extentZ[index]);
+
+			auto inside = _mm_cmpeq_ps(centerX, centerX);
+
+			for (const auto& plane : planes)
+			{
+				auto distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(plane.x)), _mm_mul_ps(centerY, _mm_set1_ps(plane.y))),
+					_mm_add_ps(_mm_mul_ps(centerZ, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w))
+				);
+
+				auto radius = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(extentX, _mm_set1_ps(std::abs(plane.x))), _mm_mul_ps(extentY, _mm_set1_ps(std::abs(plane.y)))),
+					_mm_mul_ps(extentZ, _mm_set1_ps(std::abs(plane.z)))
+				);
+
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+			}
+
+			const auto mask = _mm_movemask_ps(inside);
+
+			for (uint32_t lane = 0; lane < 4; lane++)
+			{
+				visible[index + lane] = (mask >> lane) & 1;
+			}
+		}
+#endif
+
+		for (; index < count; index++)
+		{
+			const glm::vec3 center{ bounds.centerX[index], bounds.centerY[index], bounds.centerZ[index] };
+			const glm::vec3 extents{ bounds.extentX[index], bounds.extentY[index], bounds.extentZ[index] };
+
+			visible[index] = Intersects(center, extents);
+		}
+	}
+}
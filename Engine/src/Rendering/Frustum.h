@@ -0,0 +1,48 @@
+#pragma once
+
+namespace Engine
+{
+	class AABB;
+
+	// World space bounds kept as one array per component, so a frustum can test four of them at a time
+	class CullingBounds
+	{
+	public:
+		void Clear();
+		void Add(const AABB& bounds);
+		void Set(uint32_t index, const AABB& bounds);
+		// Moves the last bounds into the removed slot
+		void Remove(uint32_t index);
+
+		[[nodiscard]] glm::vec3 GetCenter(uint32_t index) const;
+		[[nodiscard]] uint32_t GetCount() const;
+
+	private:
+		std::vector<float> centerX;
+		std::vector<float> centerY;
+		std::vector<float> centerZ;
+
+		std::vector<float> extentX;
+		std::vector<float> extentY;
+		std::vector<float> extentZ;
+
+		friend class Frustum;
+	};
+
+	class Frustum
+	{
+	public:
+		// Extracts the planes of a view projection matrix with a zero to one depth range, facing inwards
+		explicit Frustum(const glm::mat4& viewProjection);
+
+		[[nodiscard]] bool Intersects(const AABB& bounds) const;
+
+		// Sets visible[i] to 1 if the i-th bounds touch the frustum and to 0 otherwise
+		void Cull(const CullingBounds& bounds, std::vector<uint8_t>& visible) const;
+
+	private:
+		[[nodiscard]] bool Intersects(glm::vec3 center, glm::vec3 extents) const;
+
+		std::array<glm::vec4, 6> planes;
+	};
+}
@@ -0,0 +1,232 @@
+#include "GeometryBuffer.h"
+
+#include "Vulkan/CommandBuffer.h"
+#include "Vulkan/Device.h"
+
+namespace Engine
+{
+	// Keeps every index offset a multiple of the largest index type
+	constexpr uint32_t indexAlignment = sizeof(uint32_t);
+
+	uint32_t GetIndexTypeSize(VkIndexType type)
+	{
+		switch (type)
+		{
+			case VK_INDEX_TYPE_UINT8_KHR:
+				return sizeof(uint8_t);
+			case VK_INDEX_TYPE_UINT16:
+				return sizeof(uint16_t);
+			case VK_INDEX_TYPE_UINT32:
+				return sizeof(uint32_t);
+			default:
+				return 0;
+		}
+	}
+
+	GeometryAllocation::GeometryAllocation(GeometryBuffer& owner, GeometryArena& arena, uint32_t firstVertex, uint32_t vertexCount, uint32_t indexOffset, uint32_t indexSize)
+		: owner(&owner), arena(&arena), firstVertex(firstVertex), vertexCount(vertexCount), indexOffset(indexOffset), indexSize(indexSize)
+	{
+	}
+
+	GeometryAllocation::~GeometryAllocation()
+	{
+		Release();
+	}
+
+	GeometryAllocation::GeometryAllocation(GeometryAllocation&& other) noexcept
+		: owner(std::exchange(other.owner, nullptr)), arena(std::exchange(other.arena, nullptr)),
+		  firstVertex(other.firstVertex), vertexCount(other.vertexCount), indexOffset(other.indexOffset), indexSize(other.indexSize)
+	{
+	}
+
+	GeometryAllocation& GeometryAllocation::operator=(GeometryAllocation&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+
+			owner = std::exchange(other.owner, nullptr);
+			arena = std::exchange(other.arena, nullptr);
+			firstVertex = other.firstVertex;
+			vertexCount = other.vertexCount;
+			indexOffset = other.indexOffset;
+			indexSize = other.indexSize;
+		}
+
+		return *this;
+	}
+
+	void GeometryAllocation::Bind(Vulkan::CommandBuffer& commandBuffer, VkIndexType indexType, GeometryBinding& binding) const
+	{
+		if (binding.vertices != arena)
+		{
+			constexpr VkDeviceSize offsets[] = { 0 };
+			vkCmdBindVertexBuffers(commandBuffer.GetHandle(), 0, 1, &arena->vertices->GetHandle(), offsets);
+
+			binding.vertices = arena;
+		}
+
+		if (indexSize > 0 && (binding.indices != arena || binding.indexType != indexType))
+		{
+			vkCmdBindIndexBuffer(commandBuffer.GetHandle(), arena->indices->GetHandle(), 0, indexType);
+
+			binding.indices = arena;
+			binding.indexType = indexType;
+		}
+	}
+
+	bool GeometryAllocation::IsValid() const
+	{
+		return arena != nullptr;
+	}
+
+	const GeometryArena* GeometryAllocation::GetArena() const
+	{
+		return arena;
+	}
+
+	uint32_t GeometryAllocation::GetFirstVertex() const
+	{
+		return firstVertex;
+	}
+
+	uint32_t GeometryAllocation::GetFirstIndex(VkIndexType indexType) const
+	{
+		return indexOffset / GetIndexTypeSize(indexType);
+	}
+
+	void GeometryAllocation::Release()
+	{
+		if (owner)
+		{
+			owner->Free(*this);
+		}
+
+		owner = nullptr;
+		arena = nullptr;
+	}
+
+	GeometryBuffer::GeometryBuffer(Vulkan::Device& device) : device(device)
+	{
+	}
+
+	GeometryAllocation GeometryBuffer::Allocate(std::span<const Vertex> vertices, std::span<const uint8_t> indices)
+	{
+		if (vertices.empty())
+		{
+			return {};
+		}
+
+		const auto vertexCount = static_cast<uint32_t>(vertices.size());
+		const auto vertexSize = static_cast<uint32_t>(vertices.size_bytes());
+		const auto indexSize = static_cast<uint32_t>(indices.size());
+
+		uint32_t firstVertex{ 0 };
+		uint32_t indexOffset{ 0 };
+
+		auto allocate = [&](GeometryArena& arena) {
+			const auto vertexOffset = arena.vertexAllocator.Allocate(vertexCount);
+
+			if (!vertexOffset)
+			{
+				return false;
+			}
+
+			const auto indexRange = indexSize > 0 ? arena.indexAllocator.Allocate(indexSize, indexAlignment) : std::optional<uint32_t>{ 0 };
+
+			if (!indexRange)
+			{
+				arena.vertexAllocator.Free(*vertexOffset, vertexCount);
+				return false;
+			}
+
+			firstVertex = *vertexOffset;
+			indexOffset = *indexRange;
+
+			return true;
+		};
+
+		GeometryArena* arena{ nullptr };
+
+		for (auto& candidate : arenas)
+		{
+			if (allocate(*candidate))
+			{
+				arena = candidate.get();
+				break;
+			}
+		}
+
+		if (!arena)
+		{
+			arena = &CreateArena(vertexCount, indexSize);
+			allocate(*arena);
+		}
+
+		auto staging = Vulkan::BufferBuilder()
+			.Size(vertexSize + indexSize)
+			.Persistent()
+			.SequentialWrite()
+			.BufferUsage(Vulkan::BufferUsageFlags::Staging)
+			.Build(device);
+
+		staging->SetData(vertices.data(), vertexSize);
+
+		if (indexSize > 0)
+		{
+			staging->SetData(indices.data(), indexSize, vertexSize);
+		}
+
+		device.OneTimeSubmit([&](auto& commandBuffer) {
+			commandBuffer.CopyBuffer(staging->GetHandle(), arena->vertices->GetHandle(), vertexSize, 0, firstVertex * sizeof(Vertex));
+
+			if (indexSize > 0)
+			{
+				commandBuffer.CopyBuffer(staging->GetHandle(), arena->indices->GetHandle(), indexSize, vertexSize, indexOffset);
+			}
+		});
+
+		device.ResetCommandPool();
+
+		return { *this, *arena, firstVertex, vertexCount, indexOffset, indexSize };
+	}
+
+	size_t GeometryBuffer::GetArenaCount() const
+	{
+		return arenas.size();
+	}
+
+	// Primitives larger than the default arena size get an arena of their own size
+	GeometryArena& GeometryBuffer::CreateArena(uint32_t vertexCount, uint32_t indexSize)
+	{
+		const auto vertexCapacity = std::max<uint32_t>(VERTEX_ARENA_SIZE / sizeof(Vertex), vertexCount);
+		const auto indexCapacity = std::max<uint32_t>(INDEX_ARENA_SIZE, indexSize);
+
+		auto vertexBuffer = Vulkan::BufferBuilder()
+			.Size(vertexCapacity * sizeof(Vertex))
+			.BufferUsage(Vulkan::BufferUsageFlags::Vertex)
+			.Build(device);
+
+		auto indexBuffer = Vulkan::BufferBuilder()
+			.Size(indexCapacity)
+			.BufferUsage(Vulkan::BufferUsageFlags::Index)
+			.Build(device);
+
+		arenas.push_back(std::make_unique<GeometryArena>(GeometryArena{
+			.vertices = std::move(vertexBuffer),
+			.indices = std::move(indexBuffer),
+			.vertexAllocator = FreeListAllocator{ vertexCapacity },
+			.indexAllocator = FreeListAllocator{ indexCapacity },
+		}));
+
+		return *arenas.back();
+	}
+
+	void GeometryBuffer::Free(GeometryAllocation& allocation)
+	{
+		auto& arena = *allocation.arena;
+
+		arena.vertexAllocator.Free(allocation.firstVertex, allocation.vertexCount);
+		arena.indexAllocator.Free(allocation.indexOffset, allocation.indexSize);
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Vulkan/Buffer.h"
+
+#include "Common/FreeListAllocator.h"
+
+#include "Vertex.h"
+
+namespace Vulkan
+{
+	class CommandBuffer;
+	class Device;
+}
+
+namespace Engine
+{
+	class GeometryBuffer;
+
+	// A device local vertex and index buffer pair mesh geometry is sub-allocated from
+	struct GeometryArena
+	{
+		std::unique_ptr<Vulkan::Buffer> vertices;
+		std::unique_ptr<Vulkan::Buffer> indices;
+
+		// Vertices are allocated by count, so an allocation's offset is its vertex offset. Indices by byte.
+		FreeListAllocator vertexAllocator;
+		FreeListAllocator indexAllocator;
+	};
+
+	// Arena buffers bound on a command buffer, draws from the same arena and index type skip binding them again
+	struct GeometryBinding
+	{
+		const GeometryArena* vertices{ nullptr };
+		const GeometryArena* indices{ nullptr };
+		VkIndexType indexType{ VK_INDEX_TYPE_MAX_ENUM };
+	};
+
+	uint32_t GetIndexTypeSize(VkIndexType type);
+
+	// The vertices and indices of one primitive inside an arena, given back to it when destroyed
+	class GeometryAllocation
+	{
+	public:
+		GeometryAllocation() = default;
+		GeometryAllocation(GeometryBuffer& owner, GeometryArena& arena, uint32_t firstVertex, uint32_t vertexCount, uint32_t indexOffset, uint32_t indexSize);
+		~GeometryAllocation();
+
+		GeometryAllocation(GeometryAllocation&& other) noexcept;
+		GeometryAllocation& operator=(GeometryAllocation&& other) noexcept;
+
+		GeometryAllocation(const GeometryAllocation&) = delete;
+		GeometryAllocation& operator=(const GeometryAllocation&) = delete;
+
+		void Bind(Vulkan::CommandBuffer& commandBuffer, VkIndexType indexType, GeometryBinding& binding) const;
+
+		[[nodiscard]] bool IsValid() const;
+		[[nodiscard]] const GeometryArena* GetArena() const;
+		[[nodiscard]] uint32_t GetFirstVertex() const;
+		[[nodiscard]] uint32_t GetFirstIndex(VkIndexType indexType) const;
+
+	private:
+		friend class GeometryBuffer;
+
+		void Release();
+
+		GeometryBuffer* owner{ nullptr };
+		GeometryArena* arena{ nullptr };
+
+		uint32_t firstVertex{ 0 };
+		uint32_t vertexCount{ 0 };
+		uint32_t indexOffset{ 0 };
+		uint32_t indexSize{ 0 };
+	};
+
+	// Holds the geometry of every uploaded mesh in a few large arenas instead of a buffer pair per primitive.
+	// A new arena is only created once no existing one has room for a primitive.
+	class GeometryBuffer
+	{
+	public:
+		static constexpr uint32_t VERTEX_ARENA_SIZE = 64 * 1024 * 1024;
+		static constexpr uint32_t INDEX_ARENA_SIZE = 32 * 1024 * 1024;
+
+		explicit GeometryBuffer(Vulkan::Device& device);
+
+		// Copies the data to the arena through a staging buffer and waits for the copy to finish
+		GeometryAllocation Allocate(std::span<const Vertex> vertices, std::span<const uint8_t> indices);
+
+		[[nodiscard]] size_t GetArenaCount() const;
+
+	private:
+		friend class GeometryAllocation;
+
+		GeometryArena& CreateArena(uint32_t vertexCount, uint32_t indexSize);
+		void Free(GeometryAllocation& allocation);
+
+		std::vector<std::unique_ptr<GeometryArena>> arenas;
+
+		Vulkan::Device& device;
+	};
+}
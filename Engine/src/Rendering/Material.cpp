@@ -16,6 +16,11 @@ namespace Engine
 	{
 	}
 
+	void Material::UploadToGpu(Vulkan::Device& device)
+	{
+		slot = device.GetMaterialTable().Add(*this);
+	}
+
 	void Material::PrepareShaderVariant()
 	{
 		if (albedoTexture)
@@ -79,9 +84,28 @@ namespace Engine
 		return alphaCutoff;
 	}
 
+	uint32_t Material::GetMaterialIndex() const
+	{
+		assert(slot.IsValid());
+
+		return slot.GetIndex();
+	}
+
+	uint32_t Material::GetSortId() const
+	{
+		return SortIdPool::GetIndex(sortId);
+	}
+
 	const ShaderVariant& Material::GetShaderVariant() const
 	{
 		return shaderVariant;
 	}
 
+	SortIdPool& Material::GetSortIdPool()
+	{
+		static SortIdPool pool;
+
+		return pool;
+	}
+
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Texture.h"
+#include "MaterialTable.h"
+#include "SortIdPool.h"
 
 #include "Common/Hash.h"
 #include "Resource/Resource.h"
@@ -42,6 +44,8 @@ namespace Engine
 
 		~Material() override = default;
 
+		void UploadToGpu(Vulkan::Device& device);
+
 		[[nodiscard]] Texture* GetAlbedoTexture() const;
 
 		[[nodiscard]] Texture* GetNormalTexture() const;
@@ -58,6 +62,12 @@ namespace Engine
 
 		[[nodiscard]] float GetAlphaCutoff() const;
 
+		// Index of the material's parameters in the device's material table
+		[[nodiscard]] uint32_t GetMaterialIndex() const;
+
+		// Small id unique among live materials, for ordering draws by material
+		[[nodiscard]] uint32_t GetSortId() const;
+
 		[[nodiscard]] ResourceType GetType() const override
 		{
 			return ResourceType::Material;
@@ -73,11 +83,18 @@ namespace Engine
 			ar(alphaMode, alphaCutoff);
 
 			PrepareShaderVariant();
+
+			if constexpr (Archive::is_loading::value)
+			{
+				UploadToGpu(cereal::get_user_data<Vulkan::Device>(ar));
+			}
 		}
 
 	private:
 		void PrepareShaderVariant();
 
+		static SortIdPool& GetSortIdPool();
+
 		std::shared_ptr<Texture> albedoTexture;
 		std::shared_ptr<Texture> normalTexture;
 		std::shared_ptr<Texture> metallicRoughnessTexture;
@@ -90,6 +107,10 @@ namespace Engine
 		float alphaCutoff{ 0.5f };
 
 		ShaderVariant shaderVariant;
+
+		MaterialSlot slot;
+
+		SortId sortId{ GetSortIdPool().Add() };
 	};
 };
 
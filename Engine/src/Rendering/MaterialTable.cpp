@@ -0,0 +1,77 @@
+#include "MaterialTable.h"
+
+#include "Vulkan/CommandBuffer.h"
+#include "Vulkan/Device.h"
+
+#include "Material.h"
+
+namespace Engine
+{
+	MaterialTable::MaterialTable(Vulkan::Device& device) : device(device)
+	{
+		buffer = Vulkan::BufferBuilder()
+			.Size(GetSize())
+			.BufferUsage(Vulkan::BufferUsageFlags::Storage)
+			.Build(device);
+	}
+
+	MaterialSlot MaterialTable::Add(const Material& material)
+	{
+		const auto index = indices.Allocate(1);
+
+		if (!index)
+		{
+			throw std::runtime_error("material table is full");
+		}
+
+		auto textureIndex = [](const Texture* texture) { return texture ? texture->GetTextureIndex() : 0u; };
+
+		const MaterialData data{
+			.albedoColor = material.GetAlbedoColor(),
+			.metallicFactor = material.GetMetallicFactor(),
+			.roughnessFactor = material.GetRoughnessFactor(),
+			.alphaCutoff = material.GetAlphaCutoff(),
+			.albedoTexture = textureIndex(material.GetAlbedoTexture()),
+			.normalTexture = textureIndex(material.GetNormalTexture()),
+			.metallicRoughnessTexture = textureIndex(material.GetMetallicRoughnessTexture()),
+		};
+
+		auto staging = Vulkan::BufferBuilder()
+			.Size(sizeof(MaterialData))
+			.Persistent()
+			.SequentialWrite()
+			.BufferUsage(Vulkan::BufferUsageFlags::Staging)
+			.Build(device);
+
+		staging->SetData(&data, sizeof(MaterialData));
+
+		device.OneTimeSubmit([&](auto& commandBuffer) {
+			commandBuffer.CopyBuffer(staging->GetHandle(), buffer->GetHandle(), sizeof(MaterialData), 0, *index * sizeof(MaterialData));
+		});
+
+		device.ResetCommandPool();
+
+		return { *this, *index };
+	}
+
+	const Vulkan::Buffer& MaterialTable::GetBuffer() const
+	{
+		return *buffer;
+	}
+
+	uint32_t MaterialTable::GetSize() const
+	{
+		return MAX_MATERIALS * sizeof(MaterialData);
+	}
+
+	uint32_t MaterialTable::GetMaterialCount() const
+	{
+		return MAX_MATERIALS - indices.GetFreeSize();
+	}
+
+	// Nothing is cleared, an index is only read by draws of the material that owns it
+	void MaterialTable::Remove(uint32_t index)
+	{
+		indices.Free(index, 1);
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Vulkan/Buffer.h"
+
+#include "Common/FreeListAllocator.h"
+
+#include "TableSlot.h"
+
+namespace Vulkan
+{
+	class Device;
+}
+
+namespace Engine
+{
+	class Material;
+	class MaterialTable;
+
+	using MaterialSlot = TableSlot<MaterialTable>;
+
+	// Layout of one material in the shaders' material buffer, padded to its std430 array stride
+	struct MaterialData
+	{
+		glm::vec4 albedoColor;
+		float metallicFactor;
+		float roughnessFactor;
+		float alphaCutoff;
+		uint32_t albedoTexture;
+		uint32_t normalTexture;
+		uint32_t metallicRoughnessTexture;
+		uint32_t padding[2];
+	};
+
+	// The parameters of every loaded material in one device local storage buffer. A material is written once
+	// when it's added, so draws only have to tell the shader its index.
+	class MaterialTable
+	{
+	public:
+		static constexpr uint32_t MAX_MATERIALS = 4096;
+
+		explicit MaterialTable(Vulkan::Device& device);
+
+		// Copies the material's parameters to the buffer through a staging buffer and waits for the copy to finish
+		MaterialSlot Add(const Material& material);
+
+		[[nodiscard]] const Vulkan::Buffer& GetBuffer() const;
+		[[nodiscard]] uint32_t GetSize() const;
+
+		[[nodiscard]] uint32_t GetMaterialCount() const;
+
+	private:
+		friend class TableSlot<MaterialTable>;
+
+		void Remove(uint32_t index);
+
+		Vulkan::Device& device;
+
+		std::unique_ptr<Vulkan::Buffer> buffer;
+
+		FreeListAllocator indices{ MAX_MATERIALS };
+	};
+}
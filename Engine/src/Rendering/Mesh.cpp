@@ -15,23 +15,7 @@ namespace Engine
 
     void Primitive::SetIndices(std::vector<uint8_t>&& indices, const VkIndexType type)
     {
-        uint32_t typeSize{};
-        switch (type)
-        {
-            case VK_INDEX_TYPE_UINT8_KHR:
-                typeSize = sizeof(uint8_t);
-            break;
-            case VK_INDEX_TYPE_UINT16:
-                typeSize = sizeof(uint16_t);
-            break;
-            case VK_INDEX_TYPE_UINT32:
-                typeSize = sizeof(uint32_t);
-            break;
-            default:
-                break;
-        }
-
-        indexCount = indices.size() / typeSize;
+        indexCount = indices.size() / GetIndexTypeSize(type);
         indexType = type;
 
         this->indices = std::move(indices);
@@ -39,47 +23,60 @@ namespace Engine
 
     void Primitive::UploadToGpu(Vulkan::Device &device)
     {
-        vertexBuffer = Vulkan::BufferBuilder()
-            .Size(sizeof(Vertex) * vertexCount)
-            .Persistent()
-            .AllowTransfer()
-            .SequentialWrite()
-            .BufferUsage(Vulkan::BufferUsageFlags::Vertex)
-            .Build(device);
-
-        vertexBuffer->SetData(vertices.data(), sizeof(Vertex) * vertexCount);
+        geometry = device.GetGeometryBuffer().Allocate(vertices, indices);
 
         vertices.clear();
         vertices.shrink_to_fit();
 
-        indexBuffer = Vulkan::BufferBuilder()
-            .Size(indices.size())
-            .Persistent()
-            .AllowTransfer()
-            .SequentialWrite()
-            .BufferUsage(Vulkan::BufferUsageFlags::Index)
-            .Build(device);
-
-        indexBuffer->SetData(indices.data(), indices.size());
-
         indices.clear();
         indices.shrink_to_fit();
     }
 
-    void Primitive::Draw(Vulkan::CommandBuffer& commandBuffer) const
+    void Primitive::Draw(Vulkan::CommandBuffer& commandBuffer, GeometryBinding& binding, uint32_t instanceCount, uint32_t firstInstance) const
     {
-        constexpr VkDeviceSize offsets[] = { 0 };
-        vkCmdBindVertexBuffers(commandBuffer.GetHandle(), 0, 1, &vertexBuffer->GetHandle(), offsets);
-         
-        if (indexBuffer != nullptr)
+        if (!geometry.IsValid())
+        {
+            return;
+        }
+
+        BindGeometry(commandBuffer, binding);
+
+        const auto firstVertex = geometry.GetFirstVertex();
+
+        if (indexCount > 0)
         {
-            vkCmdBindIndexBuffer(commandBuffer.GetHandle(), indexBuffer->GetHandle(), 0, indexType);
-            commandBuffer.DrawIndexed(indexCount, 1, 0, 0, 0);
+            commandBuffer.DrawIndexed(indexCount, instanceCount, geometry.GetFirstIndex(indexType), static_cast<int32_t>(firstVertex), firstInstance);
 
             return;
         }
 
-        commandBuffer.Draw(vertexCount, 1, 0, 0);
+        commandBuffer.Draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+
+    void Primitive::BindGeometry(Vulkan::CommandBuffer& commandBuffer, GeometryBinding& binding) const
+    {
+        geometry.Bind(commandBuffer, indexType, binding);
+    }
+
+    std::optional<VkDrawIndexedIndirectCommand> Primitive::GetIndirectCommand(uint32_t instanceCount, uint32_t firstInstance) const
+    {
+        if (!geometry.IsValid() || indexCount == 0)
+        {
+            return std::nullopt;
+        }
+
+        return VkDrawIndexedIndirectCommand{
+            .indexCount = static_cast<uint32_t>(indexCount),
+            .instanceCount = instanceCount,
+            .firstIndex = geometry.GetFirstIndex(indexType),
+            .vertexOffset = static_cast<int32_t>(geometry.GetFirstVertex()),
+            .firstInstance = firstInstance,
+        };
+    }
+
+    bool Primitive::SharesGeometryBuffers(const Primitive& other) const
+    {
+        return geometry.GetArena() == other.geometry.GetArena() && indexType == other.indexType;
     }
 
     void Primitive::SetMaterial(std::shared_ptr<Material> material)
@@ -92,6 +89,18 @@ namespace Engine
         return material.get();
     }
 
+    uint32_t Primitive::GetSortId() const
+    {
+        return SortIdPool::GetIndex(sortId);
+    }
+
+    SortIdPool& Primitive::GetSortIdPool()
+    {
+        static SortIdPool pool;
+
+        return pool;
+    }
+
     void Mesh::UploadToGpu(Vulkan::Device &device)
     {
         for (auto& primitive : primitives)
@@ -4,12 +4,13 @@
 #include <cereal/types/vector.hpp>
 
 #include "Vulkan/Device.h"
-#include "Vulkan/Buffer.h"
 #include "Vulkan/CommandBuffer.h"
 
 #include "Resource/Resource.h"
 
+#include "GeometryBuffer.h"
 #include "Material.h"
+#include "SortIdPool.h"
 #include "Vertex.h"
 
 namespace Engine
@@ -29,13 +30,18 @@ namespace Engine
 			return (min + max) * 0.5f;
 		}
 
+		[[nodiscard]] glm::vec3 GetExtents() const
+		{
+			return (max - min) * 0.5f;
+		}
+
 		void Transform(const glm::mat4& matrix)
 		{
 			glm::vec3 min = this->min;
 			glm::vec3 max = this->max;
 
 			this->min = glm::vec3{ std::numeric_limits<float>::max() };
-			this->max = glm::vec3{ std::numeric_limits<float>::min() };
+			this->max = glm::vec3{ std::numeric_limits<float>::lowest() };
 
 			Update(matrix * glm::vec4(min, 1.0f));
 			Update(matrix * glm::vec4(min.x, min.y, max.z, 1.0f));
@@ -68,14 +74,25 @@ namespace Engine
 		void SetIndices(std::vector<uint8_t>&& indices, VkIndexType type);
 		void SetVertices(std::vector<Vertex>&& vertices);
 
+		// Moves the geometry into the device's geometry buffer, the CPU copy is released afterwards
 		void UploadToGpu(Vulkan::Device& device);
 
-		void Draw(Vulkan::CommandBuffer& commandBuffer) const;
+		// Binds the geometry buffer arena holding the primitive unless binding says it is already bound
+		void Draw(Vulkan::CommandBuffer& commandBuffer, GeometryBinding& binding, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+		void BindGeometry(Vulkan::CommandBuffer& commandBuffer, GeometryBinding& binding) const;
+
+		// The draw as an indirect command, only indexed primitives already uploaded have one
+		[[nodiscard]] std::optional<VkDrawIndexedIndirectCommand> GetIndirectCommand(uint32_t instanceCount, uint32_t firstInstance) const;
+		// Whether both index into the same arena buffers, so their indirect commands can be issued together
+		[[nodiscard]] bool SharesGeometryBuffers(const Primitive& other) const;
 
 		void SetMaterial(std::shared_ptr<Material> material);
 
 		[[nodiscard]] Material* GetMaterial() const;
 
+		// Small id unique among live primitives, for keeping the instances of a primitive together when sorting draws
+		[[nodiscard]] uint32_t GetSortId() const;
+
 		template<typename Archive>
 		void Serialize(Archive& archive)
 		{
@@ -83,6 +100,8 @@ namespace Engine
 		}
 
 	private:
+		static SortIdPool& GetSortIdPool();
+
 		std::vector<uint8_t> indices;
 		std::vector<Vertex> vertices;
 
@@ -90,10 +109,11 @@ namespace Engine
 		size_t indexCount{ 0 };
 		VkIndexType indexType{ VK_INDEX_TYPE_MAX_ENUM };
 
-		std::unique_ptr<Vulkan::Buffer> vertexBuffer;
-		std::unique_ptr<Vulkan::Buffer> indexBuffer;
+		GeometryAllocation geometry;
 
 		std::shared_ptr<Material> material;
+
+		SortId sortId{ GetSortIdPool().Add() };
 	};
 
 	class Mesh final : public Resource
@@ -47,14 +47,14 @@ namespace Engine
                 height,
                 RenderTextureFormat::HDR,
                 RenderTextureUsage::RenderTarget | RenderTextureUsage::Sampled,
-        });
+        }, "GBuffer");
 
         data.depth = builder.Allocate<RenderTexture>({
                 width,
                 height,
                 RenderTextureFormat::Depth,
                 RenderTextureUsage::RenderTarget,
-        });
+        }, "Depth");
 
         builder.Write(data.gBuffer, {
             .type = RenderTextureAccessType::Attachment,
@@ -8,16 +8,45 @@
 
 namespace Engine
 {
-    ShadowPass::ShadowPass(Scene& scene, ShadowSettings settings) : scene(scene), settings(settings) { }
+	Camera GetShadowCamera()
+	{
+		Camera camera;
+		camera.SetOrthographic(50, -25.f, 25.f);
+
+		return camera;
+	}
+
+	glm::mat4 GetShadowViewProjection(glm::vec3 lightDirection)
+	{
+		auto view = glm::lookAt(-lightDirection, glm::vec3{ 0, 0, 0 }, glm::vec3{ 0, 1, 0 });
+
+		return GetShadowCamera().GetProjection() * view;
+	}
+
+	std::optional<glm::vec3> GetMainLightDirection(Scene& scene)
+	{
+		const auto query = scene.Query<Component::Transform, Component::DirectionalLight>();
+
+		if (const auto entity = query.First(); scene.Valid(entity))
+		{
+			const auto& transform = scene.GetComponent<Component::Transform>(entity);
+
+			return glm::normalize(transform.rotation * glm::vec3{ 0, 0, 1 });
+		}
+
+		return std::nullopt;
+	}
+
+    ShadowPass::ShadowPass(Scene& scene, const ShadowSettings& settings) : scene(scene), settings(settings) { }
 
 	void ShadowPass::RecordRenderGraph(RenderGraphBuilder& builder, RenderGraphContext& context, ShadowPassData& data)
 	{
 		data.shadowMap = builder.Allocate<RenderTexture>({
-			.width = 2048,
-			.height = 2048,
+			.width = shadowMapResolution,
+			.height = shadowMapResolution,
 			.format = RenderTextureFormat::Depth,
 			.usage = RenderTextureUsage::RenderTarget | RenderTextureUsage::Sampled
-		});
+		}, "ShadowMap");
 
 		builder.Write(data.shadowMap, {
 			.type = RenderTextureAccessType::Attachment,
@@ -26,24 +55,57 @@ namespace Engine
 			}
 		});
 
-		const auto query = scene.Query<Component::Transform, Component::DirectionalLight>();
-
-		if (const auto entity = query.First(); scene.Valid(entity))
+		if (settings.mode == ShadowMode::CachedStatic && context.Has<StaticShadowData>())
 		{
-			const auto& transform = scene.GetComponent<Component::Transform>(entity);
+			builder.Read(context.Get<StaticShadowData>().shadowMap, {
+				.type = RenderTextureAccessType::Binding,
+				.binding = {
+					.set = 0,
+					.location = 1,
+				}
+			});
 
-			data.lightDirection = glm::normalize(transform.rotation * glm::vec3{ 0, 0, 1 });
+			data.cached = true;
 		}
 
 		context.Add<ShadowPassData>(data);
 	}
 
 	void ShadowPass::Render(RenderGraphCommand& command, const ShadowPassData& data)
+	{
+		if (data.cached)
+		{
+			command.Blit("shadowcopy");
+		}
+
+		command.DrawShadow({
+			.lightDirection = GetMainLightDirection(scene).value_or(glm::vec3{}),
+			.depthBias = settings.depthBias,
+			.normalBias = settings.normalBias,
+		});
+	}
+
+	StaticShadowPass::StaticShadowPass(Scene& scene, const ShadowSettings& settings) : scene(scene), settings(settings) { }
+
+	void StaticShadowPass::RecordRenderGraph(RenderGraphBuilder& builder, RenderGraphContext& context, StaticShadowPassData& data)
+	{
+		data.shadowMap = context.Get<StaticShadowData>().shadowMap;
+
+		builder.Write(data.shadowMap, {
+			.type = RenderTextureAccessType::Attachment,
+			.attachment = {
+				.aspect = RenderTextureAspect::Depth,
+			}
+		});
+	}
+
+	void StaticShadowPass::Render(RenderGraphCommand& command, const StaticShadowPassData& data)
 	{
 		command.DrawShadow({
-			.lightDirection = data.lightDirection,
+			.lightDirection = GetMainLightDirection(scene).value_or(glm::vec3{}),
 			.depthBias = settings.depthBias,
 			.normalBias = settings.normalBias,
+			.casters = ShadowCasters::Static,
 		});
 	}
 }
@@ -8,27 +8,67 @@
 
 namespace Engine
 {
+	enum class ShadowMode
+	{
+		// Every caster is drawn into a new shadow map each frame
+		Dynamic,
+		// Casters that stopped moving are kept in a persistent shadow map, redrawn only when one of them or the light changes.
+		// Each frame starts from a copy of it and draws the moving casters on top.
+		CachedStatic,
+	};
+
 	struct ShadowSettings
 	{
 		float depthBias{ 4 };
 		float normalBias{ 0.8 };
+		ShadowMode mode{ ShadowMode::Dynamic };
+		// Frames a caster has to stay unchanged before it moves into the cached shadow map
+		uint32_t staticFrames{ 30 };
 	};
 
+	inline constexpr uint32_t shadowMapResolution = 2048;
+
+	// The main directional light's shadow map covers a fixed orthographic volume around the origin
+	Camera GetShadowCamera();
+	glm::mat4 GetShadowViewProjection(glm::vec3 lightDirection);
+
+	// Direction of the first directional light in the scene, if there is one
+	std::optional<glm::vec3> GetMainLightDirection(Scene& scene);
+
 	struct ShadowPassData
 	{
 		RenderGraphResourceHandle<RenderTexture> shadowMap;
-		glm::vec3 lightDirection;
+		// Whether the pass starts from the cached static shadow map
+		bool cached{ false };
+	};
+
+	struct StaticShadowPassData
+	{
+		RenderGraphResourceHandle<RenderTexture> shadowMap;
+	};
+
+	// Redraws the static casters into the imported cached shadow map, only part of the graph on frames where it changed
+	class StaticShadowPass final : public RenderGraphPass<StaticShadowPassData, RenderGraphCommand>
+	{
+	public:
+		StaticShadowPass(Scene& scene, const ShadowSettings& settings);
+
+		void RecordRenderGraph(RenderGraphBuilder& builder, RenderGraphContext& context, StaticShadowPassData& data) override;
+		void Render(RenderGraphCommand& command, const StaticShadowPassData& data) override;
+	private:
+		Scene& scene;
+		const ShadowSettings& settings;
 	};
 
 	class ShadowPass final : public RenderGraphPass<ShadowPassData, RenderGraphCommand>
 	{
 	public:
-		ShadowPass(Scene& scene, ShadowSettings settings);
+		ShadowPass(Scene& scene, const ShadowSettings& settings);
 
 		void RecordRenderGraph(RenderGraphBuilder& builder, RenderGraphContext& context, ShadowPassData& data) override;
 		void Render(RenderGraphCommand& command, const ShadowPassData& data) override;
 	private:
 		Scene& scene;
-		ShadowSettings settings;
+		const ShadowSettings& settings;
 	};
 }
@@ -10,21 +10,22 @@ namespace Engine
 
 	BufferAllocation BufferPool::Allocate(uint32_t size)
 	{
-		auto& activeBlock = blocks[activeBlockIndex];
-
-		if (activeBlock->CanAllocate(size))
+		while (activeBlockIndex < blocks.size())
 		{
-			return activeBlock->Allocate(size);
-		}
+			auto& activeBlock = blocks[activeBlockIndex];
 
-		activeBlockIndex++;
+			if (activeBlock->CanAllocate(size))
+			{
+				return activeBlock->Allocate(size);
+			}
 
-		if (blocks.size() <= activeBlockIndex)
-		{
-			blocks.emplace_back(std::make_unique<BufferBlock>(device, blockSize, usage));
+			activeBlockIndex++;
 		}
-		
-		return blocks[activeBlockIndex]->Allocate(size);
+
+		// Allocations bigger than a block, like large instance buffers, get a block of their own size
+		blocks.emplace_back(std::make_unique<BufferBlock>(device, std::max(blockSize, size), usage));
+
+		return blocks.back()->Allocate(size);
 	}
 
 	void BufferPool::Reset()
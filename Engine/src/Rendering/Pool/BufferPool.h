@@ -36,7 +36,8 @@ namespace Engine
 	private:
 		std::unique_ptr<Vulkan::Buffer> buffer;
 
-		uint32_t alignment = 0;
+		// Uniform blocks use the device limit, everything else only needs to stay aligned for vec4 attributes
+		uint32_t alignment = 16;
 		uint32_t offset = 0;
 	};
 
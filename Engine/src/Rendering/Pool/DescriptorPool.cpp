@@ -4,7 +4,7 @@
 namespace Engine
 {
 	DescriptorPool::DescriptorPool(const Vulkan::Device& device, Vulkan::DescriptorSetLayout& descriptorSetLayout, uint32_t size)
-		: device(device), descriptorSetLayout(descriptorSetLayout), size(size)
+		: device(device), descriptorSetLayout(descriptorSetLayout), size(size), generation(device.GetDescriptorGeneration())
 	{
 		entries.emplace_back(std::make_unique<DescriptorPoolEntry>(device, descriptorSetLayout, size));
 	}
@@ -36,6 +36,65 @@ namespace Engine
 		}
 
 		activeEntryIndex = 0;
+
+		sets.clear();
+		stale = false;
+		generation = device.GetDescriptorGeneration();
+	}
+
+	VkDescriptorSet DescriptorPool::Find(const DescriptorSetKey& key, uint64_t frame)
+	{
+		if (IsStale())
+		{
+			return VK_NULL_HANDLE;
+		}
+
+		auto it = sets.find(key);
+
+		if (it == sets.end())
+		{
+			return VK_NULL_HANDLE;
+		}
+
+		it->second.lastUsed = frame;
+
+		return it->second.handle;
+	}
+
+	void DescriptorPool::Insert(const DescriptorSetKey& key, VkDescriptorSet set, uint64_t frame)
+	{
+		sets[key] = { set, frame };
+	}
+
+	void DescriptorPool::Trim(uint64_t frame, uint64_t maxUnusedFrames)
+	{
+		if (IsStale())
+		{
+			Reset();
+			return;
+		}
+
+		const auto unused = std::ranges::count_if(sets, [&](const auto& entry) {
+			return frame - entry.second.lastUsed > maxUnusedFrames;
+		});
+
+		// Single sets can't be freed, so the pool only starts over once it is mostly made of unused ones
+		if (unused * 2 > static_cast<std::ptrdiff_t>(sets.size()))
+		{
+			Reset();
+		}
+	}
+
+	bool DescriptorPool::IsStale()
+	{
+		if (!stale && generation != device.GetDescriptorGeneration())
+		{
+			// Sets handed out this frame may still be recorded, so they stay allocated until the next trim
+			sets.clear();
+			stale = true;
+		}
+
+		return stale;
 	}
 
 	DescriptorPoolEntry::DescriptorPoolEntry(const Vulkan::Device& device, Vulkan::DescriptorSetLayout& descriptorSetLayout, uint32_t size)
@@ -4,6 +4,60 @@
 #include "Vulkan/Device.h"
 #include "Vulkan/DescriptorSetLayout.h"
 
+#include "Common/Hash.h"
+
+namespace Engine
+{
+	// Everything a descriptor set was written with, flattened to words so it can be hashed and compared
+	struct DescriptorSetKey
+	{
+		std::vector<uint64_t> words;
+
+		template <typename... Args>
+		void Add(Args... args)
+		{
+			(words.push_back(ToWord(args)), ...);
+		}
+
+		void Clear()
+		{
+			words.clear();
+		}
+
+		bool operator==(const DescriptorSetKey& other) const = default;
+
+	private:
+		template <typename T>
+		static uint64_t ToWord(T value)
+		{
+			if constexpr (std::is_pointer_v<T>)
+			{
+				return reinterpret_cast<uintptr_t>(value);
+			}
+			else
+			{
+				return static_cast<uint64_t>(value);
+			}
+		}
+	};
+}
+
+template <>
+struct std::hash<Engine::DescriptorSetKey>
+{
+	size_t operator()(const Engine::DescriptorSetKey& key) const noexcept
+	{
+		std::size_t hash{ 0 };
+
+		for (auto word : key.words)
+		{
+			HashCombine(hash, word);
+		}
+
+		return hash;
+	}
+};
+
 namespace Engine
 {
 	class DescriptorPoolEntry
@@ -31,12 +85,34 @@ namespace Engine
 		VkDescriptorSet Allocate();
 		void Reset();
 
+		// A set written earlier with the same key, or a null handle. Sets are cached until the pool is trimmed.
+		VkDescriptorSet Find(const DescriptorSetKey& key, uint64_t frame);
+		void Insert(const DescriptorSetKey& key, VkDescriptorSet set, uint64_t frame);
+
+		// Resets the pool once most cached sets went unused for maxUnusedFrames or a resource they may reference was
+		// destroyed. Only safe once the GPU is done with every set of the pool, like when its frame begins again.
+		void Trim(uint64_t frame, uint64_t maxUnusedFrames);
+
 	private:
+		struct CachedSet
+		{
+			VkDescriptorSet handle{ VK_NULL_HANDLE };
+			uint64_t lastUsed{ 0 };
+		};
+
+		// Descriptor set handles may point to objects destroyed since they were written, once the device generation
+		// moved on every cached set is dropped and the pool is reset on the next trim
+		bool IsStale();
+
 		const Vulkan::Device& device;
 		Vulkan::DescriptorSetLayout& descriptorSetLayout;
 		uint32_t size;
 
 		std::vector<std::unique_ptr<DescriptorPoolEntry>> entries;
 		uint32_t activeEntryIndex = 0;
+
+		std::unordered_map<DescriptorSetKey, CachedSet> sets;
+		uint64_t generation{ 0 };
+		bool stale{ false };
 	};
 }
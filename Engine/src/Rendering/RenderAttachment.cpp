@@ -116,15 +116,38 @@ namespace Engine
 		return *this;
 	}
 
+	RenderAttachment::Builder& RenderAttachment::Builder::Alias(VmaAllocation memory)
+	{
+		this->alias = memory;
+
+		return *this;
+	}
+
 	std::unique_ptr<RenderAttachment> RenderAttachment::Builder::Build()
 	{
-		auto image = std::make_unique<Vulkan::Image>(
-			device,
-			usage,
-			format,
-			VkExtent3D{ extent.width, extent.height, 1 },
-			sampleCount
-		);
+		std::unique_ptr<Vulkan::Image> image;
+
+		if (alias != VK_NULL_HANDLE)
+		{
+			image = std::make_unique<Vulkan::Image>(
+				device,
+				alias,
+				usage,
+				format,
+				VkExtent3D{ extent.width, extent.height, 1 },
+				sampleCount
+			);
+		}
+		else
+		{
+			image = std::make_unique<Vulkan::Image>(
+				device,
+				usage,
+				format,
+				VkExtent3D{ extent.width, extent.height, 1 },
+				sampleCount
+			);
+		}
 
 		auto attachment = std::make_unique<RenderAttachment>(
 			device,
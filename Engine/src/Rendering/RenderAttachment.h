@@ -9,8 +9,8 @@ namespace Engine
 {
 	struct BarrierScope
 	{
-		VkAccessFlags access{ 0 };
-		VkPipelineStageFlags stage{ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT };
+		VkAccessFlags2 access{ VK_ACCESS_2_NONE };
+		VkPipelineStageFlags2 stage{ VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT };
 	};
 
 	class RenderAttachment
@@ -64,6 +64,7 @@ namespace Engine
 			Builder& ClearValue(VkClearValue clearValue);
 			Builder& LoadStoreInfo(Vulkan::LoadStoreInfo loadStoreInfo);
 			Builder& Resolve(std::unique_ptr<RenderAttachment>&& resolve);
+			Builder& Alias(VmaAllocation memory);
 			std::unique_ptr<RenderAttachment> Build();
 
 		private:
@@ -77,6 +78,7 @@ namespace Engine
 			Vulkan::LoadStoreInfo loadStoreInfo{};
 
 			std::unique_ptr<RenderAttachment> resolve{ nullptr };
+			VmaAllocation alias{ VK_NULL_HANDLE };
 		};
 	};
 
@@ -4,40 +4,482 @@
 #include "Renderer.h"
 #include "Scene/Scene.h"
 
+#include "Common/RadixSort.h"
+#include "Common/ThreadPool.h"
+
 namespace Engine
 {
+	enum class RenderQueue : uint64_t
+	{
+		Opaque,
+		Transparent,
+	};
+
+	uint64_t Fold16(size_t hash)
+	{
+		return (hash ^ (hash >> 16) ^ (hash >> 32) ^ (hash >> 48)) & 0xffff;
+	}
+
+	// Distances are never negative, so the bits of the float already order like the value and the top ones make a logarithmic bucket
+	uint64_t QuantizeDepth(float distance, uint32_t bits)
+	{
+		return std::bit_cast<uint32_t>(std::max(distance, 0.f)) >> (32 - bits);
+	}
+
+	// queue:2 | pipeline:16 | material:16 | mesh:16 | depth:14, front to back
+	uint64_t GetOpaqueSortKey(const Primitive& primitive, float distance)
+	{
+		const auto* material = primitive.GetMaterial();
+
+		return static_cast<uint64_t>(RenderQueue::Opaque) << 62
+			| Fold16(material->GetShaderVariant().GetHash()) << 46
+			| static_cast<uint64_t>(material->GetSortId()) << 30
+			| static_cast<uint64_t>(primitive.GetSortId()) << 14
+			| QuantizeDepth(distance, 14);
+	}
+
+	// queue:2 | depth:30, back to front | pipeline:16 | material:16
+	uint64_t GetTransparentSortKey(const Primitive& primitive, float distance)
+	{
+		const auto* material = primitive.GetMaterial();
+
+		constexpr uint64_t depthMask = (1ull << 30) - 1;
+
+		return static_cast<uint64_t>(RenderQueue::Transparent) << 62
+			| (~QuantizeDepth(distance, 30) & depthMask) << 32
+			| Fold16(material->GetShaderVariant().GetHash()) << 16
+			| material->GetSortId();
+	}
+
+	// mesh:32 | depth:32, front to back from the light. The shadow pass binds a single pipeline and no material,
+	// so only keeping instances of a primitive together matters.
+	uint64_t GetShadowCasterSortKey(const Primitive& primitive, float lightDepth)
+	{
+		return static_cast<uint64_t>(primitive.GetSortId()) << 32 | QuantizeDepth(lightDepth, 32);
+	}
+
     void RenderBatcher::BuildBatches(Scene& scene, const RenderCamera& camera)
     {
-		auto cameraPosition = camera.GetPosition();
+		Prepare(scene, camera);
+
+		buckets.resize(1);
+		Emit(0, static_cast<uint32_t>(objects.size()), camera.GetPosition(), buckets[0]);
 
-		auto query = scene.Query<Component::MeshRender, Component::LocalToWorld>();
+		Finish();
+    }
+
+	void RenderBatcher::BuildBatches(Scene& scene, const RenderCamera& camera, ThreadPool& threads)
+	{
+		// Below this many entities per chunk handing work to the pool costs more than it saves
+		constexpr uint32_t minChunkSize = 1024;
+
+		Prepare(scene, camera);
 
-		for (const auto entity : query)
+		const auto count = static_cast<uint32_t>(objects.size());
+		const auto chunks = std::clamp((count + minChunkSize - 1) / minChunkSize, 1u, threads.GetThreadCount());
+		const auto chunkSize = (count + chunks - 1) / chunks;
+
+		buckets.resize(chunks);
+
+		// The calling thread takes the last chunk instead of idling in Wait
+		for (uint32_t chunk = 0; chunk < chunks; chunk++)
 		{
-			auto [meshRender, localToWorld] = query.GetComponent(entity);
+			const auto first = std::min(chunk * chunkSize, count);
+			const auto last = std::min(first + chunkSize, count);
 
-			auto mesh = meshRender.mesh;
+			auto emit = [this, first, last, &camera, &bucket = buckets[chunk]] {
+				Emit(first, last, camera.GetPosition(), bucket);
+			};
 
-			for (auto& primitive : mesh->GetPrimitives())
+			if (chunk + 1 == chunks)
 			{
-				auto bounds = mesh->GetBounds();
-				bounds.Transform(localToWorld.value);
+				emit();
+				continue;
+			}
 
-				auto distance = glm::length2(bounds.GetCenter() - glm::vec3{ cameraPosition });
+			threads.Submit(emit);
+		}
+
+		threads.Wait();
+
+		Finish();
+	}
 
+	void RenderBatcher::Prepare(Scene& scene, const RenderCamera& camera)
+	{
+		Reset();
+
+		if (&scene != this->scene)
+		{
+			Attach(scene);
+		}
+
+		frame++;
+
+		ApplyChanges();
+		PromoteSettled();
+
+		const Frustum frustum{ camera.GetProjection() * glm::inverse(camera.GetTransform()) };
+		frustum.Cull(objectBounds, visible);
+
+		lightDirection = GetMainLightDirection(scene);
+
+		if (lightDirection != previousLightDirection)
+		{
+			previousLightDirection = lightDirection;
+			staticVersion++;
+		}
+
+		staticShadowChanges = staticVersion != builtStaticVersion;
+		builtStaticVersion = staticVersion;
+
+		if (!lightDirection)
+		{
+			shadowVisible.assign(objects.size(), 0);
+			return;
+		}
+
+		shadowOrigin = -*lightDirection * (1.f - GetShadowCamera().GetNear());
+
+		const Frustum shadowFrustum{ GetShadowViewProjection(*lightDirection) };
+		shadowFrustum.Cull(objectBounds, shadowVisible);
+	}
+
+	void RenderBatcher::Emit(uint32_t first, uint32_t last, glm::vec3 cameraPosition, RenderBucket& bucket) const
+	{
+		bucket.opaques.clear();
+		bucket.transparents.clear();
+		bucket.shadowCasters.clear();
+		bucket.staticShadowCasters.clear();
+
+		for (uint32_t index = first; index < last; index++)
+		{
+			const auto& object = objects[index];
+			const auto& transform = object.transform;
+			const auto center = objectBounds.GetCenter(index);
+			const auto distance = glm::length2(center - cameraPosition);
+			const auto caster = object.castShadows && shadowVisible[index];
+
+			// Static casters are only needed when the cached shadow map gets redrawn
+			auto* casters = cacheStaticCasters && object.isStatic
+				? (staticShadowChanges ? &bucket.staticShadowCasters : nullptr)
+				: &bucket.shadowCasters;
+
+			for (auto& primitive : object.mesh->GetPrimitives())
+			{
 				if (const auto material = primitive.GetMaterial(); material->GetAlphaMode() == AlphaMode::Blend)
 				{
-					transparents.emplace_back(localToWorld.value, &primitive, distance);
+					if (visible[index])
+					{
+						bucket.transparents.emplace_back(transform, &primitive, GetTransparentSortKey(primitive, distance));
+					}
+
 					continue;
 				}
 
-				opaques.emplace_back(localToWorld.value, &primitive, distance);
+				// Off screen geometry can still cast a shadow into view
+				if (caster && casters)
+				{
+					const auto lightDepth = glm::dot(center - shadowOrigin, *lightDirection);
+
+					casters->emplace_back(transform, &primitive, GetShadowCasterSortKey(primitive, lightDepth));
+				}
+
+				if (visible[index])
+				{
+					bucket.opaques.emplace_back(transform, &primitive, GetOpaqueSortKey(primitive, distance));
+				}
 			}
 		}
+	}
+
+	// Buckets are appended in chunk order and the sort is stable, so equal keys keep their entity order
+	void RenderBatcher::Finish()
+	{
+		for (const auto& bucket : buckets)
+		{
+			opaques.insert(opaques.end(), bucket.opaques.begin(), bucket.opaques.end());
+			transparents.insert(transparents.end(), bucket.transparents.begin(), bucket.transparents.end());
+			shadowCasters.insert(shadowCasters.end(), bucket.shadowCasters.begin(), bucket.shadowCasters.end());
+			staticShadowCasters.insert(staticShadowCasters.end(), bucket.staticShadowCasters.begin(), bucket.staticShadowCasters.end());
+		}
 
 		SortOpaques();
 		SortTransparents();
-    }
+		RadixSort(shadowCasters, scratch, [](const RenderGeometry& geometry) { return geometry.key; });
+		RadixSort(staticShadowCasters, scratch, [](const RenderGeometry& geometry) { return geometry.key; });
+
+		// Transparents keep their back to front order, so only opaques are merged
+		BuildInstances(opaques, opaqueBatches, true);
+		BuildInstances(transparents, transparentBatches, false);
+		BuildInstances(shadowCasters, shadowCasterBatches, true);
+		BuildInstances(staticShadowCasters, staticShadowCasterBatches, true);
+
+		// The shadow map shader doesn't use materials, so casters only split where the geometry buffers change
+		BuildDraws(opaqueBatches, opaqueDraws, true);
+		BuildDraws(transparentBatches, transparentDraws, true);
+		BuildDraws(shadowCasterBatches, shadowCasterDraws, false);
+		BuildDraws(staticShadowCasterBatches, staticShadowCasterDraws, false);
+	}
+
+	void RenderBatcher::SetShadowSettings(const ShadowSettings& settings)
+	{
+		const auto cache = settings.mode == ShadowMode::CachedStatic;
+
+		if (cache != cacheStaticCasters)
+		{
+			cacheStaticCasters = cache;
+			staticVersion++;
+		}
+
+		staticFrames = settings.staticFrames;
+	}
+
+	RenderBatcher::~RenderBatcher()
+	{
+		Detach();
+	}
+
+	void RenderBatcher::Detach()
+	{
+		if (!scene)
+		{
+			return;
+		}
+
+		scene->DisconnectComponentEvents<Component::MeshRender>(this);
+		scene->DisconnectComponentEvents<Component::LocalToWorld>(this);
+		scene->DisconnectComponentEvents<Component::Delete>(this);
+		scene->DisconnectTeardown(this);
+
+		scene = nullptr;
+
+		objects.clear();
+		objectBounds.Clear();
+		slots.clear();
+		changes.clear();
+		settling.clear();
+	}
+
+	void RenderBatcher::Attach(Scene& scene)
+	{
+		Detach();
+
+		this->scene = &scene;
+
+		// Assigning another scene keeps the address, so the entity cache can't outlive the contents it was built from
+		scene.OnTeardown<&RenderBatcher::Detach>(this);
+
+		scene.OnComponentAdded<Component::MeshRender, &RenderBatcher::OnRenderableChanged>(this);
+		scene.OnComponentUpdated<Component::MeshRender, &RenderBatcher::OnRenderableChanged>(this);
+		scene.OnComponentRemoved<Component::MeshRender, &RenderBatcher::OnRenderableChanged>(this);
+
+		scene.OnComponentAdded<Component::LocalToWorld, &RenderBatcher::OnRenderableChanged>(this);
+		scene.OnComponentUpdated<Component::LocalToWorld, &RenderBatcher::OnRenderableChanged>(this);
+		scene.OnComponentRemoved<Component::LocalToWorld, &RenderBatcher::OnRenderableChanged>(this);
+
+		// Entities waiting to be deleted are already left out of every query
+		scene.OnComponentAdded<Component::Delete, &RenderBatcher::OnRenderableChanged>(this);
+
+		staticVersion++;
+
+		for (const auto entity : scene.Query<Component::MeshRender, Component::LocalToWorld>())
+		{
+			changes.push_back(entity);
+		}
+	}
+
+	void RenderBatcher::OnRenderableChanged(Entity::Id entity)
+	{
+		changes.push_back(entity);
+	}
+
+	// Signals fire before a component is gone, so what an entity still has is only looked at here
+	void RenderBatcher::ApplyChanges()
+	{
+		for (const auto entity : changes)
+		{
+			if (!scene->Valid(entity) || scene->HasComponent<Component::Delete>(entity))
+			{
+				RemoveObject(entity);
+				continue;
+			}
+
+			const auto meshRender = scene->TryGetComponent<Component::MeshRender>(entity);
+			const auto localToWorld = scene->TryGetComponent<Component::LocalToWorld>(entity);
+
+			if (!meshRender || !localToWorld || !meshRender->mesh)
+			{
+				RemoveObject(entity);
+				continue;
+			}
+
+			UpdateObject(entity, *meshRender->mesh, meshRender->castShadows, localToWorld->value);
+		}
+
+		changes.clear();
+	}
+
+	void RenderBatcher::UpdateObject(Entity::Id entity, const Mesh& mesh, bool castShadows, const glm::mat4& transform)
+	{
+		auto bounds = mesh.GetBounds();
+		bounds.Transform(transform);
+
+		auto [it, added] = slots.try_emplace(entity, static_cast<uint32_t>(objects.size()));
+
+		if (added)
+		{
+			objects.emplace_back();
+			objectBounds.Add(bounds);
+		}
+		else
+		{
+			objectBounds.Set(it->second, bounds);
+		}
+
+		auto& object = objects[it->second];
+
+		// A change to a cached caster invalidates the cached shadow map, the caster waits to settle again
+		if (added || object.isStatic)
+		{
+			staticVersion += object.isStatic;
+			settling.push_back(entity);
+		}
+
+		object = {
+			.entity = entity,
+			.mesh = &mesh,
+			.castShadows = castShadows,
+			.isStatic = false,
+			.lastChanged = frame,
+			.transform = transform,
+		};
+	}
+
+	void RenderBatcher::PromoteSettled()
+	{
+		std::erase_if(settling, [&](Entity::Id entity) {
+			const auto it = slots.find(entity);
+
+			if (it == slots.end() || objects[it->second].isStatic)
+			{
+				return true;
+			}
+
+			auto& object = objects[it->second];
+
+			if (frame - object.lastChanged < staticFrames)
+			{
+				return false;
+			}
+
+			object.isStatic = true;
+			staticVersion++;
+
+			return true;
+		});
+	}
+
+	void RenderBatcher::RemoveObject(Entity::Id entity)
+	{
+		const auto it = slots.find(entity);
+
+		if (it == slots.end())
+		{
+			return;
+		}
+
+		const auto index = it->second;
+		slots.erase(it);
+
+		staticVersion += objects[index].isStatic;
+
+		objects[index] = objects.back();
+		objects.pop_back();
+		objectBounds.Remove(index);
+
+		if (index < objects.size())
+		{
+			slots[objects[index].entity] = index;
+		}
+	}
+
+	void RenderBatcher::Reset()
+	{
+		opaques.clear();
+		transparents.clear();
+		shadowCasters.clear();
+		staticShadowCasters.clear();
+
+		opaqueBatches.clear();
+		transparentBatches.clear();
+		shadowCasterBatches.clear();
+		staticShadowCasterBatches.clear();
+		instances.clear();
+
+		opaqueDraws.clear();
+		transparentDraws.clear();
+		shadowCasterDraws.clear();
+		staticShadowCasterDraws.clear();
+		drawCommands.clear();
+	}
+
+	uint32_t RenderBatcher::GetObjectCount() const
+	{
+		return static_cast<uint32_t>(objects.size());
+	}
+
+	void RenderBatcher::BuildInstances(const std::vector<RenderGeometry>& geometries, std::vector<RenderBatch>& batches, bool merge)
+	{
+		for (const auto& geometry : geometries)
+		{
+			const auto index = static_cast<uint32_t>(instances.size());
+
+			instances.push_back(geometry.transform);
+
+			if (merge && !batches.empty() && batches.back().primitive == geometry.primitive)
+			{
+				batches.back().instanceCount++;
+				continue;
+			}
+
+			batches.push_back({ geometry.primitive, index, 1 });
+		}
+	}
+
+	void RenderBatcher::BuildDraws(const std::vector<RenderBatch>& batches, std::vector<RenderDraw>& draws, bool shareMaterial)
+	{
+		for (uint32_t index = 0; index < batches.size(); index++)
+		{
+			const auto& batch = batches[index];
+			const auto& primitive = *batch.primitive;
+			const auto command = primitive.GetIndirectCommand(batch.instanceCount, batch.firstInstance);
+
+			if (!command)
+			{
+				draws.push_back({ &primitive, index, 1 });
+				continue;
+			}
+
+			drawCommands.push_back(*command);
+
+			if (!draws.empty())
+			{
+				auto& last = draws.back();
+
+				const auto compatible = last.indirect && last.primitive->SharesGeometryBuffers(primitive)
+					&& (!shareMaterial || last.primitive->GetMaterial() == primitive.GetMaterial());
+
+				if (compatible)
+				{
+					last.batchCount++;
+					continue;
+				}
+			}
+
+			draws.push_back({ &primitive, index, 1, static_cast<uint32_t>(drawCommands.size() - 1), true });
+		}
+	}
 
 	const std::vector<RenderGeometry>& RenderBatcher::GetOpaques()
 	{
@@ -49,29 +491,68 @@ namespace Engine
 		return transparents;
 	}
 
-	void RenderBatcher::SortOpaques()
+	const std::vector<RenderBatch>& RenderBatcher::GetOpaqueBatches()
 	{
-		auto sort = [](const RenderGeometry& a, const RenderGeometry& b)
-		{
-			std::size_t hashA{ 0 };
-			Hash(hashA, a.primitive->GetMaterial());
+		return opaqueBatches;
+	}
 
-			std::size_t hashB{ 0 };
-			Hash(hashB, b.primitive->GetMaterial());
+	const std::vector<RenderBatch>& RenderBatcher::GetTransparentBatches()
+	{
+		return transparentBatches;
+	}
 
-			return hashA < hashB;
-		};
+	const std::vector<RenderBatch>& RenderBatcher::GetShadowCasterBatches()
+	{
+		return shadowCasterBatches;
+	}
 
-		std::ranges::sort(opaques, sort);
+	const std::vector<RenderBatch>& RenderBatcher::GetStaticShadowCasterBatches()
+	{
+		return staticShadowCasterBatches;
 	}
 
-	void RenderBatcher::SortTransparents()
+	const std::vector<RenderDraw>& RenderBatcher::GetOpaqueDraws()
 	{
-		auto sort = [](const RenderGeometry& a, const RenderGeometry& b)
-		{
-			return a.distance > b.distance;
-		};
+		return opaqueDraws;
+	}
+
+	const std::vector<RenderDraw>& RenderBatcher::GetTransparentDraws()
+	{
+		return transparentDraws;
+	}
 
-		std::ranges::sort(transparents, sort);
+	const std::vector<RenderDraw>& RenderBatcher::GetShadowCasterDraws()
+	{
+		return shadowCasterDraws;
+	}
+
+	const std::vector<RenderDraw>& RenderBatcher::GetStaticShadowCasterDraws()
+	{
+		return staticShadowCasterDraws;
+	}
+
+	const std::vector<VkDrawIndexedIndirectCommand>& RenderBatcher::GetDrawCommands()
+	{
+		return drawCommands;
+	}
+
+	bool RenderBatcher::HasStaticShadowChanges() const
+	{
+		return staticShadowChanges;
+	}
+
+	const std::vector<glm::mat4>& RenderBatcher::GetInstances()
+	{
+		return instances;
+	}
+
+	void RenderBatcher::SortOpaques()
+	{
+		RadixSort(opaques, scratch, [](const RenderGeometry& geometry) { return geometry.key; });
+	}
+
+	void RenderBatcher::SortTransparents()
+	{
+		RadixSort(transparents, scratch, [](const RenderGeometry& geometry) { return geometry.key; });
 	}
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "Frustum.h"
+
+#include "Scene/Entity.h"
+
 namespace Engine
 {
     class Scene;
@@ -7,30 +11,173 @@ namespace Engine
     class RenderContext;
     class Primitive;
     class Material;
+    class Mesh;
+    class ThreadPool;
+    struct ShadowSettings;
 
     struct RenderGeometry
     {
         glm::mat4 transform{};
 		const Primitive* primitive{ nullptr };
-		float distance{ 0.f };
+		// Packed queue, pipeline, material, mesh and depth, see GetOpaqueSortKey and GetTransparentSortKey
+		uint64_t key{ 0 };
     };
 
+    uint64_t GetOpaqueSortKey(const Primitive& primitive, float distance);
+    uint64_t GetTransparentSortKey(const Primitive& primitive, float distance);
+    uint64_t GetShadowCasterSortKey(const Primitive& primitive, float lightDepth);
+
+    // Consecutive instances of one primitive, drawn with a single instanced call
+    struct RenderBatch
+    {
+		const Primitive* primitive{ nullptr };
+		uint32_t firstInstance{ 0 };
+		uint32_t instanceCount{ 0 };
+    };
+
+    // Consecutive batches issued by one indirect draw of batchCount commands, starting at firstCommand.
+    // Batches that can't be drawn indirectly, like non indexed primitives, get a direct draw of their own.
+    struct RenderDraw
+    {
+		const Primitive* primitive{ nullptr };
+		uint32_t firstBatch{ 0 };
+		uint32_t batchCount{ 0 };
+		uint32_t firstCommand{ 0 };
+		bool indirect{ false };
+    };
+
+    // Keeps every renderable entity of a scene cached between frames, only entities whose mesh or transform changed
+    // are refreshed. It stays connected to the last scene it built from until that scene is torn down.
     class RenderBatcher
     {
     public:
+        ~RenderBatcher();
+
         void BuildBatches(Scene& scene, const RenderCamera& camera);
+        // Splits the cached entities into one chunk per thread of the pool, every chunk filling its own buckets
+        // which are merged in chunk order before sorting, so the result matches the single threaded build
+        void BuildBatches(Scene& scene, const RenderCamera& camera, ThreadPool& threads);
+
+        // Picks whether static casters are split from the moving ones, applied on the next build
+        void SetShadowSettings(const ShadowSettings& settings);
 
 		const std::vector<RenderGeometry>& GetOpaques();
 		const std::vector<RenderGeometry>& GetTransparents();
 
+		const std::vector<RenderBatch>& GetOpaqueBatches();
+		const std::vector<RenderBatch>& GetTransparentBatches();
+		// Opaque geometry casting shadows inside the main light's shadow volume, whether it is in view or not
+		const std::vector<RenderBatch>& GetShadowCasterBatches();
+		// Casters that stayed unchanged long enough to be cached, only built on frames HasStaticShadowChanges() is true
+		const std::vector<RenderBatch>& GetStaticShadowCasterBatches();
+
+		// Batches grouped into indirect draws, opaques and transparents by material and geometry arena, casters only by arena
+		const std::vector<RenderDraw>& GetOpaqueDraws();
+		const std::vector<RenderDraw>& GetTransparentDraws();
+		const std::vector<RenderDraw>& GetShadowCasterDraws();
+		const std::vector<RenderDraw>& GetStaticShadowCasterDraws();
+
+		// Indirect commands of every draw, indexed by their firstCommand
+		const std::vector<VkDrawIndexedIndirectCommand>& GetDrawCommands();
+
+		// Whether the static casters or the light changed since the previous build, so a cached shadow map of them is stale
+		[[nodiscard]] bool HasStaticShadowChanges() const;
+
+		// Transforms of every batch, indexed by their instances
+		const std::vector<glm::mat4>& GetInstances();
+
+		// Entities in the cache, drawn or not
+		[[nodiscard]] uint32_t GetObjectCount() const;
+
 		void Reset();
 
+		// Disconnects from the attached scene and drops its cached entities, the next build attaches again
+		void Detach();
+
     private:
+		void Attach(Scene& scene);
+		void ApplyChanges();
+		void OnRenderableChanged(Entity::Id entity);
+		void UpdateObject(Entity::Id entity, const Mesh& mesh, bool castShadows, const glm::mat4& transform);
+		void RemoveObject(Entity::Id entity);
+		void PromoteSettled();
+
+		// Geometry emitted by one chunk of the cached entities
+		struct RenderBucket
+		{
+			std::vector<RenderGeometry> opaques;
+			std::vector<RenderGeometry> transparents;
+			std::vector<RenderGeometry> shadowCasters;
+			std::vector<RenderGeometry> staticShadowCasters;
+		};
+
+		void Prepare(Scene& scene, const RenderCamera& camera);
+		void Emit(uint32_t first, uint32_t last, glm::vec3 cameraPosition, RenderBucket& bucket) const;
+		void Finish();
+
 		Material& GetMaterial(const Primitive& primitive);
 		void SortOpaques();
 		void SortTransparents();
+		void BuildInstances(const std::vector<RenderGeometry>& geometries, std::vector<RenderBatch>& batches, bool merge);
+		void BuildDraws(const std::vector<RenderBatch>& batches, std::vector<RenderDraw>& draws, bool shareMaterial);
+
+        // A renderable entity of the attached scene, its world space bounds live at the same index in objectBounds
+        struct RenderObject
+        {
+            Entity::Id entity{ Entity::Null };
+            const Mesh* mesh{ nullptr };
+            bool castShadows{ true };
+            // Static once unchanged for staticFrames builds
+            bool isStatic{ false };
+            uint64_t lastChanged{ 0 };
+            glm::mat4 transform{};
+        };
+
+        Scene* scene{ nullptr };
+
+        std::vector<RenderObject> objects;
+        CullingBounds objectBounds;
+        std::unordered_map<Entity::Id, uint32_t> slots;
+        // Entities whose mesh or transform changed since the last build, may hold duplicates
+        std::vector<Entity::Id> changes;
+        // Entities not static yet, checked every build until they settle
+        std::vector<Entity::Id> settling;
+
+        bool cacheStaticCasters{ false };
+        uint32_t staticFrames{ 0 };
+        uint64_t frame{ 0 };
+
+        // Bumped whenever a static caster or the light changes, compared against the version of the previous build
+        uint64_t staticVersion{ 1 };
+        uint64_t builtStaticVersion{ 0 };
+        bool staticShadowChanges{ false };
+
+        std::vector<uint8_t> visible;
+        std::vector<uint8_t> shadowVisible;
+
+        // Main light of the frame being built and the near plane of its shadow volume, casters are sorted by their depth from it
+        std::optional<glm::vec3> lightDirection;
+        std::optional<glm::vec3> previousLightDirection;
+        glm::vec3 shadowOrigin{};
+
+        std::vector<RenderBucket> buckets;
 
         std::vector<RenderGeometry> opaques;
         std::vector<RenderGeometry> transparents;
+        std::vector<RenderGeometry> shadowCasters;
+        std::vector<RenderGeometry> staticShadowCasters;
+        std::vector<RenderGeometry> scratch;
+
+        std::vector<RenderBatch> opaqueBatches;
+        std::vector<RenderBatch> transparentBatches;
+        std::vector<RenderBatch> shadowCasterBatches;
+        std::vector<RenderBatch> staticShadowCasterBatches;
+        std::vector<glm::mat4> instances;
+
+        std::vector<RenderDraw> opaqueDraws;
+        std::vector<RenderDraw> transparentDraws;
+        std::vector<RenderDraw> shadowCasterDraws;
+        std::vector<RenderDraw> staticShadowCasterDraws;
+        std::vector<VkDrawIndexedIndirectCommand> drawCommands;
     };
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Pool/BufferPool.h"
 
+#include "RenderTexture.h"
+
 namespace Engine
 {
     class RenderGraphCommand;
@@ -12,10 +14,16 @@ namespace Engine
         uint32_t size{};
     };
 
+    inline std::string Describe(const RenderBufferDesc& desc)
+    {
+        return std::to_string(desc.size) + " bytes";
+    }
+
     struct RenderBufferAccessInfo
     {
         uint32_t set{};
         uint32_t binding{};
+        RenderGraphPipelineStage stages{ RenderGraphPipelineStage::VertexShader | RenderGraphPipelineStage::FragmentShader };
     };
 
     struct RenderBuffer
@@ -27,6 +35,8 @@ namespace Engine
         using Command = RenderGraphCommand;
 
         BufferAllocation allocation{};
+        // Only transient buffers written on the GPU are tracked, imported ones are filled by the host before submission
+        BarrierScope* scope{ nullptr };
     };
 }
 
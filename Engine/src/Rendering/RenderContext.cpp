@@ -32,6 +32,8 @@ namespace Engine
             .MinImageCount(3)
             .Build(*device, *surface);
 
+		threadPool = std::make_unique<ThreadPool>();
+
 		CreateFrames();
     }
 
@@ -57,7 +59,7 @@ namespace Engine
 
 			auto target = CreateRenderTarget(std::move(swapchainImage));
 
-			auto frame = std::make_unique<RenderFrame>(*device, std::move(target));
+			auto frame = std::make_unique<RenderFrame>(*device, std::move(target), threadPool->GetThreadCount());
 
 			frames.emplace_back(std::move(frame));
 		}
@@ -114,7 +116,7 @@ namespace Engine
 			barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 			barrier.srcAccessMask = scope.access;
 			barrier.srcStageMask = scope.stage;
-			barrier.dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+			barrier.dstStageMask = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT;
 
 			commandBuffer.ImageMemoryBarrier(attachment.GetView(), barrier);
 
@@ -256,4 +258,9 @@ namespace Engine
 	{
 		return *swapchain;
 	}
+
+	ThreadPool& RenderContext::GetThreadPool()
+	{
+		return *threadPool;
+	}
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "RenderFrame.h"
 
+#include "Common/ThreadPool.h"
+
 namespace Vulkan
 {
     class Instance;
@@ -35,6 +37,7 @@ namespace Engine
         Vulkan::PhysicalDevice& GetPhysicalDevice();
         Vulkan::Instance& GetInstance();
         Vulkan::Swapchain& GetSwapchain();
+        ThreadPool& GetThreadPool();
 
     private:
         void CreateFrames();
@@ -58,6 +61,8 @@ namespace Engine
 
         Vulkan::Semaphore* acquireSemaphore;
 
+        std::unique_ptr<ThreadPool> threadPool;
+
         std::vector<std::unique_ptr<RenderFrame>> frames;
     };
 }
\ No newline at end of file
@@ -5,17 +5,14 @@
 namespace Engine
 {
 
-	RenderFrame::RenderFrame(Vulkan::Device& device, std::unique_ptr<RenderTarget> target)
+	RenderFrame::RenderFrame(Vulkan::Device& device, std::unique_ptr<RenderTarget> target, uint32_t threadCount)
 		: device(device), target(std::move(target))
 	{
-		commandPool = std::make_unique<Vulkan::CommandPool>(device, this);
+		threads.resize(threadCount);
+
 		semaphorePool = std::make_unique<SemaphorePool>(device);
 
 		renderFence = std::make_unique<Vulkan::Fence>(device);
-
-		bufferPools.emplace(Vulkan::BufferUsageFlags::Uniform, std::make_unique<BufferPool>(device, Vulkan::BufferUsageFlags::Uniform, BUFFER_POOL_BLOCK_SIZE));
-		bufferPools.emplace(Vulkan::BufferUsageFlags::Vertex, std::make_unique<BufferPool>(device, Vulkan::BufferUsageFlags::Vertex, BUFFER_POOL_BLOCK_SIZE));
-		bufferPools.emplace(Vulkan::BufferUsageFlags::Index, std::make_unique<BufferPool>(device, Vulkan::BufferUsageFlags::Index, BUFFER_POOL_BLOCK_SIZE));
 	}
 
 	void RenderFrame::Reset()
@@ -23,23 +20,34 @@ namespace Engine
 		renderFence->Wait();
 		renderFence->Reset();
 
-		commandPool->Reset();
 		semaphorePool->Reset();
 
-		for (auto& [_, pool]:descriptorPools)
-		{
-			pool->Reset();
-		}
+		uses++;
 
-		for (auto& [_, pool] : bufferPools)
+		for (auto& pools : threads)
 		{
-			pool->Reset();
+			if (!pools.commandPool)
+			{
+				continue;
+			}
+
+			pools.commandPool->Reset();
+
+			for (auto& [_, pool] : pools.descriptorPools)
+			{
+				pool->Trim(uses, DESCRIPTOR_CACHE_MAX_UNUSED_FRAMES);
+			}
+
+			for (auto& [_, pool] : pools.bufferPools)
+			{
+				pool->Reset();
+			}
 		}
 	}
 
-	Vulkan::CommandBuffer& RenderFrame::RequestCommandBuffer()
+	Vulkan::CommandBuffer& RenderFrame::RequestCommandBuffer(Vulkan::CommandBuffer::Level level, uint32_t thread)
 	{
-		return commandPool->RequestCommandBuffer();
+		return GetThreadPools(thread).commandPool->RequestCommandBuffer(level);
 	}
 
 	Vulkan::Semaphore& RenderFrame::RequestSemaphore()
@@ -62,19 +70,73 @@ namespace Engine
 		return *renderFence;
 	}
 
-	VkDescriptorSet RenderFrame::RequestDescriptorSet(Vulkan::DescriptorSetLayout& descriptorSetLayout, const BindingMap<VkDescriptorBufferInfo>& bufferInfos, const BindingMap<VkDescriptorImageInfo>& imageInfos)
+	VkDescriptorSet RenderFrame::RequestDescriptorSet(Vulkan::DescriptorSetLayout& descriptorSetLayout, const BindingMap<VkDescriptorBufferInfo>& bufferInfos, const BindingMap<VkDescriptorImageInfo>& imageInfos, uint32_t thread)
 	{
-		auto handle = GetDescriptorPool(descriptorSetLayout).Allocate();
+		auto& pool = GetDescriptorPool(descriptorSetLayout, thread);
+
+		thread_local DescriptorSetKey key;
+		key.Clear();
+
+		// Dynamic buffers are written at offset zero, every offset into the same buffer shares their set
+		for (auto& [index, infos] : bufferInfos)
+		{
+			const auto dynamic = descriptorSetLayout.IsDynamic(index);
+
+			for (auto& [element, info] : infos)
+			{
+				key.Add(index, element, info.buffer, dynamic ? 0 : info.offset, info.range);
+			}
+		}
+
+		// Separates the two binding kinds, so buffers and images can never produce the same words
+		key.Add(~0ull);
+
+		for (auto& [index, infos] : imageInfos)
+		{
+			for (auto& [element, info] : infos)
+			{
+				key.Add(index, element, info.sampler, info.imageView, info.imageLayout);
+			}
+		}
+
+		if (auto cached = pool.Find(key, uses))
+		{
+			return cached;
+		}
+
+		auto handle = pool.Allocate();
 
 		thread_local std::vector<VkWriteDescriptorSet> writes;
 		writes.clear();
 
+		// Written infos are pointed to by the writes, so this never reallocates while they are built
+		thread_local std::vector<VkDescriptorBufferInfo> writtenInfos;
+		writtenInfos.clear();
+
+		size_t infoCount{ 0 };
+
+		for (auto& [index, infos] : bufferInfos)
+		{
+			infoCount += infos.size();
+		}
+
+		writtenInfos.reserve(infoCount);
+
 		for (auto& [index, infos] : bufferInfos)
 		{
 			if (auto layoutBinding = descriptorSetLayout.GetBinding(index))
 			{
+				const auto dynamic = descriptorSetLayout.IsDynamic(index);
+
 				for (auto& [element, info] : infos)
 				{
+					auto& written = writtenInfos.emplace_back(info);
+
+					if (dynamic)
+					{
+						written.offset = 0;
+					}
+
 					writes.push_back(
 						{
 							.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
@@ -83,7 +145,7 @@ namespace Engine
 							.dstArrayElement = element,
 							.descriptorCount = 1,
 							.descriptorType = layoutBinding->descriptorType,
-							.pBufferInfo = &info,
+							.pBufferInfo = &written,
 						}
 					);
 				}
@@ -113,11 +175,14 @@ namespace Engine
 
 		vkUpdateDescriptorSets(device.GetHandle(), writes.size(), writes.data(), 0, nullptr);
 
+		pool.Insert(key, handle, uses);
+
 		return handle;
 	}
 
-	BufferAllocation RenderFrame::RequestBufferAllocation(Vulkan::BufferUsageFlags usage, uint32_t size)
+	BufferAllocation RenderFrame::RequestBufferAllocation(Vulkan::BufferUsageFlags usage, uint32_t size, uint32_t thread)
 	{
+		auto& bufferPools = GetThreadPools(thread).bufferPools;
 		auto it = bufferPools.find(usage);
 
 		if (it == bufferPools.end())
@@ -140,8 +205,37 @@ namespace Engine
 		return *target;
 	}
 
-	DescriptorPool& RenderFrame::GetDescriptorPool(Vulkan::DescriptorSetLayout& descriptorSetLayout)
+	LinearAllocator& RenderFrame::GetGraphArena()
 	{
+		return graphArena;
+	}
+
+	// Pools are created the first time a thread records, only that thread ever touches its slot
+	RenderFrame::ThreadPools& RenderFrame::GetThreadPools(uint32_t thread)
+	{
+		assert(thread < threads.size());
+
+		auto& pools = threads[thread];
+
+		if (pools.commandPool)
+		{
+			return pools;
+		}
+
+		pools.commandPool = std::make_unique<Vulkan::CommandPool>(device, this, thread);
+
+		pools.bufferPools.emplace(Vulkan::BufferUsageFlags::Uniform, std::make_unique<BufferPool>(device, Vulkan::BufferUsageFlags::Uniform, BUFFER_POOL_BLOCK_SIZE));
+		pools.bufferPools.emplace(Vulkan::BufferUsageFlags::Vertex, std::make_unique<BufferPool>(device, Vulkan::BufferUsageFlags::Vertex, BUFFER_POOL_BLOCK_SIZE));
+		pools.bufferPools.emplace(Vulkan::BufferUsageFlags::Index, std::make_unique<BufferPool>(device, Vulkan::BufferUsageFlags::Index, BUFFER_POOL_BLOCK_SIZE));
+		pools.bufferPools.emplace(Vulkan::BufferUsageFlags::Indirect, std::make_unique<BufferPool>(device, Vulkan::BufferUsageFlags::Indirect, BUFFER_POOL_BLOCK_SIZE));
+
+		return pools;
+	}
+
+	DescriptorPool& RenderFrame::GetDescriptorPool(Vulkan::DescriptorSetLayout& descriptorSetLayout, uint32_t thread)
+	{
+		auto& descriptorPools = GetThreadPools(thread).descriptorPools;
+
 		std::size_t hash{ 0 };
 		Hash(hash, descriptorSetLayout);
 
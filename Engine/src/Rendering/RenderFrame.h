@@ -15,6 +15,8 @@
 
 #include "RenderTarget.h"
 
+#include "Common/LinearAllocator.h"
+
 namespace Engine
 {
 	template <typename T>
@@ -25,36 +27,55 @@ namespace Engine
 	public:
 		static constexpr uint32_t BUFFER_POOL_BLOCK_SIZE = 256 * 1024;
 		static constexpr uint32_t DESCRIPTOR_POOL_MAX_SETS = 256;
+		// Uses of this frame a cached descriptor set can go without being requested before it counts as unused
+		static constexpr uint32_t DESCRIPTOR_CACHE_MAX_UNUSED_FRAMES = 60;
 
-		RenderFrame(Vulkan::Device& device, std::unique_ptr<RenderTarget> target);
+		// Command, descriptor and buffer pools exist once per thread, so threadCount threads can record into the frame at the same time
+		RenderFrame(Vulkan::Device& device, std::unique_ptr<RenderTarget> target, uint32_t threadCount = 1);
 		~RenderFrame() = default;
 
 		void Reset();
 
-		Vulkan::CommandBuffer& RequestCommandBuffer();
+		Vulkan::CommandBuffer& RequestCommandBuffer(Vulkan::CommandBuffer::Level level = Vulkan::CommandBuffer::Level::Primary, uint32_t thread = 0);
 		Vulkan::Semaphore& RequestSemaphore();
 		Vulkan::Semaphore* RequestOwnedSemaphore();
 		void ReleaseOwnedSemaphore(Vulkan::Semaphore* semaphore);
 		Vulkan::Fence& GetRenderFence() const;
 
-		VkDescriptorSet RequestDescriptorSet(Vulkan::DescriptorSetLayout& descriptorSetLayout, const BindingMap<VkDescriptorBufferInfo>& bufferInfos, const BindingMap<VkDescriptorImageInfo>& imageInfos);
-		BufferAllocation RequestBufferAllocation(Vulkan::BufferUsageFlags usage, uint32_t size);
+		// Sets are cached by their layout and bindings, a request matching an earlier one, this frame or a previous
+		// use of it, returns the same set without allocating or writing
+		VkDescriptorSet RequestDescriptorSet(Vulkan::DescriptorSetLayout& descriptorSetLayout, const BindingMap<VkDescriptorBufferInfo>& bufferInfos, const BindingMap<VkDescriptorImageInfo>& imageInfos, uint32_t thread = 0);
+		BufferAllocation RequestBufferAllocation(Vulkan::BufferUsageFlags usage, uint32_t size, uint32_t thread = 0);
 
 		void SetTarget(std::unique_ptr<RenderTarget> target);
 		RenderTarget& GetTarget() const;
+
+		// Not reset with the frame, the renderer keeps this frame's compiled graph in it and resets it on rebuild
+		LinearAllocator& GetGraphArena();
 	private:
-		DescriptorPool& GetDescriptorPool(Vulkan::DescriptorSetLayout& descriptorSetLayout);
+		struct ThreadPools
+		{
+			std::unique_ptr<Vulkan::CommandPool> commandPool;
+
+			std::unordered_map<Vulkan::BufferUsageFlags, std::unique_ptr<BufferPool>> bufferPools;
+			std::unordered_map<std::size_t, std::unique_ptr<DescriptorPool>> descriptorPools;
+		};
+
+		ThreadPools& GetThreadPools(uint32_t thread);
+		DescriptorPool& GetDescriptorPool(Vulkan::DescriptorSetLayout& descriptorSetLayout, uint32_t thread);
 
 		Vulkan::Device& device;
 
-		std::unique_ptr<Vulkan::CommandPool> commandPool;
+		std::vector<ThreadPools> threads;
 		std::unique_ptr<SemaphorePool> semaphorePool;
 
-		std::unordered_map<Vulkan::BufferUsageFlags, std::unique_ptr<BufferPool>> bufferPools;
-		std::unordered_map<std::size_t, std::unique_ptr<DescriptorPool>> descriptorPools;
-
 		std::unique_ptr<Vulkan::Fence> renderFence;
 
 		std::unique_ptr<RenderTarget> target;
+
+		LinearAllocator graphArena;
+
+		// Times this frame was reset, ages its cached descriptor sets
+		uint64_t uses{ 0 };
 	};
 }
\ No newline at end of file
@@ -4,119 +4,447 @@
 #include "RenderGraphBuilder.h"
 #include "RenderGraphContext.h"
 #include "RenderGraphPass.h"
+#include "RenderGraphSnapshot.h"
+
+#include "Common/ThreadPool.h"
 
 namespace Engine
 {
     struct RenderGraphRecord
     {
-        std::unique_ptr<RenderGraphPassConcept> pass{ nullptr };
+        RenderGraphPtr<RenderGraphPassConcept> pass{ nullptr };
+
+        RenderGraphVector<RenderGraphResourceHandleBase> allocates;
+        RenderGraphVector<RenderGraphResourceAccess> writes;
+        RenderGraphVector<RenderGraphResourceAccess> reads;
+
+        RenderGraphVector<uint32_t> dependencies;
+        RenderGraphVector<RenderGraphResourceHandleBase> frees;
 
-        std::vector<RenderGraphResourceHandleBase> allocates;
-        std::vector<RenderGraphResourceAccess> writes;
-        std::vector<RenderGraphResourceAccess> reads;
+        std::pmr::string name;
+
+        // What the last execution of the pass cost
+        uint32_t barriers{ 0 };
+        std::chrono::nanoseconds recordTime{ 0 };
     };
 
     class RenderGraph
     {
        
     public:
+        // Every allocation the graph makes comes from memory, which has to outlive it
+        explicit RenderGraph(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+            : memory(memory), context(memory), records(memory), resources(memory), schedule(memory) {}
+
         template<typename T>
-        RenderGraphResourceHandle<T> Import(T&& resource, const typename T::Descriptor& desc)
+        RenderGraphResourceHandle<T> Import(T&& resource, const typename T::Descriptor& desc, std::string_view name = {})
         {
             auto handle = RenderGraphResourceHandle<T>(resources.size());
-            resources.push_back({ RenderGraphResource::Type::Imported, std::forward<T>(resource), desc });
+            resources.emplace_back(memory, RenderGraphResource::Type::Imported, std::forward<T>(resource), desc, name);
 
             return handle;
         }
 
+        // Swaps the resource behind an imported handle, so a compiled graph can be executed again with new frame data
+        template<typename T>
+        void Rebind(RenderGraphResourceHandle<T> handle, T&& resource)
+        {
+            GetResource(handle).template Rebind<T>(std::forward<T>(resource));
+        }
+
         template <typename Data, typename Command>
-        void AddPass(RenderGraphPass<Data, Command>& pass)
+        void AddPass(RenderGraphPass<Data, Command>& pass, std::string_view name = {})
         {
-            auto render = std::make_unique<RenderGraphPassRender<Data, Command>>(&pass);
+            auto render = MakeRenderGraphPtr<RenderGraphPassConcept, RenderGraphPassRender<Data, Command>>(memory, &pass);
+            auto& data = static_cast<RenderGraphPassRender<Data, Command>*>(render.get())->data;
 
-            RenderGraphBuilder builder{ resources };
-            pass.RecordRenderGraph(builder, context, render->data);
+            RenderGraphBuilder builder{ resources, memory };
+            pass.RecordRenderGraph(builder, context, data);
 
-            records.emplace_back(std::move(render), std::move(builder.allocates), std::move(builder.writes), std::move(builder.reads));
+            records.push_back({
+                .pass = std::move(render),
+                .allocates = std::move(builder.allocates),
+                .writes = std::move(builder.writes),
+                .reads = std::move(builder.reads),
+                .dependencies = RenderGraphVector<uint32_t>(memory),
+                .frees = RenderGraphVector<RenderGraphResourceHandleBase>(memory),
+                .name = std::pmr::string(name, memory),
+            });
         }
 
         void Compile()
         {
-            for (auto& record : records)
+            BuildDependencies();
+
+            schedule.clear();
+
+            RenderGraphVector<bool> visited(records.size(), false, memory);
+
+            // Imported resources outlive the graph, so passes writing to them are the roots everything else is pulled from
+            for (uint32_t index = 0; index < records.size(); index++)
             {
-                for (auto& access: record.reads)
-                {
-                    auto& resource = GetResource(access.GetHandle());
+                auto& record = records[index];
 
-                    resource.SetLastRecord(&record);
-                }
+                auto root = std::ranges::any_of(record.writes, [&](const auto& access) {
+                    return GetResource(access.GetHandle()).GetType() == RenderGraphResource::Type::Imported;
+                });
 
-                for (auto& access : record.writes)
+                if (root)
                 {
-                    auto& resource = GetResource(access.GetHandle());
-
-                    resource.SetLastRecord(&record);
+                    Schedule(index, visited);
                 }
             }
+
+            BuildLifetimes();
         }
 
         template<typename Command, typename Allocator>
         void Execute(Command& command, Allocator& allocator)
         {
-            for (auto& record : records)
+            for (auto index : schedule)
+            {
+                auto& record = records[index];
+
+                Prepare(record, command, allocator);
+
+                const auto start = std::chrono::steady_clock::now();
+
+                command.BeginPass();
+
+                record.pass->Render(&command);
+
+                command.EndPass();
+
+                record.recordTime = std::chrono::steady_clock::now() - start;
+
+                Release(record, allocator);
+            }
+        }
+
+        // Resources and barriers are still resolved here in schedule order, but every pass records into its own
+        // command from command.CreatePassCommand() on the thread pool. Those are handed back in schedule order
+        // through command.SubmitPassCommands() once all of them finished.
+        template<typename Command, typename Allocator>
+        void Execute(Command& command, Allocator& allocator, ThreadPool& threads)
+        {
+            for (auto index : schedule)
             {
+                auto& record = records[index];
+                auto& passCommand = command.CreatePassCommand();
+
+                Prepare(record, passCommand, allocator);
+
+                threads.Submit([&record, &passCommand] {
+                    const auto start = std::chrono::steady_clock::now();
+
+                    passCommand.BeginPass();
+
+                    record.pass->Render(&passCommand);
+
+                    passCommand.EndPass();
+
+                    record.recordTime = std::chrono::steady_clock::now() - start;
+                });
+
+                // Freeing only hands the memory to later passes, which synchronize against this one through their barriers
+                Release(record, allocator);
+            }
+
+            threads.Wait();
+
+            command.SubmitPassCommands();
+        }
+
+        RenderGraphContext& GetContext()
+        {
+            return context;
+        }
+
+        [[nodiscard]] const RenderGraphVector<uint32_t>& GetSchedule() const
+        {
+            return schedule;
+        }
+
+        // Passes left out of the schedule are kept as culled, timings and barriers are the ones of the last execution
+        [[nodiscard]] RenderGraphSnapshot GetSnapshot() const
+        {
+            RenderGraphSnapshot snapshot;
+            snapshot.passes.resize(records.size());
+            snapshot.resources.resize(resources.size());
+
+            for (uint32_t id = 0; id < resources.size(); id++)
+            {
+                auto& resource = snapshot.resources[id];
+
+                resource.name = resources[id].GetName().empty() ? "Resource " + std::to_string(id) : std::string(resources[id].GetName());
+                resource.description = resources[id].GetDescription();
+                resource.imported = resources[id].GetType() == RenderGraphResource::Type::Imported;
+            }
+
+            for (uint32_t order = 0; order < schedule.size(); order++)
+            {
+                snapshot.passes[schedule[order]].order = order;
+            }
+
+            for (uint32_t index = 0; index < records.size(); index++)
+            {
+                const auto& record = records[index];
+                auto& pass = snapshot.passes[index];
+
+                pass.name = record.name.empty() ? "Pass " + std::to_string(index) : std::string(record.name);
+                pass.dependencies.assign(record.dependencies.begin(), record.dependencies.end());
+
+                if (!pass.IsCulled())
+                {
+                    pass.barriers = record.barriers;
+                    pass.recordTime = record.recordTime;
+                }
+
+                auto touch = [&](uint32_t id) {
+                    auto& resource = snapshot.resources[id];
+
+                    if (pass.IsCulled())
+                    {
+                        return;
+                    }
+
+                    resource.first = resource.first == RenderGraphSnapshot::none ? pass.order : std::min(resource.first, pass.order);
+                    resource.last = resource.last == RenderGraphSnapshot::none ? pass.order : std::max(resource.last, pass.order);
+                };
+
                 for (auto handle : record.allocates)
                 {
-                    auto& resource = GetResource(handle);
+                    touch(handle.GetId());
+                }
+
+                for (auto& access : record.reads)
+                {
+                    touch(access.GetHandle().GetId());
 
-                    resource.Allocate(&allocator);
+                    pass.accesses.push_back({ .resource = access.GetHandle().GetId(), .write = false });
                 }
 
-                for (auto& access: record.reads)
+                for (auto& access : record.writes)
                 {
-                    auto& resource = GetResource(access.GetHandle());
+                    touch(access.GetHandle().GetId());
 
-                    access.BeforeRead(&command, resource);
+                    pass.accesses.push_back({ .resource = access.GetHandle().GetId(), .write = true, .ops = access.GetWriteOps() });
                 }
+            }
+
+            return snapshot;
+        }
+
+    private:
+        static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+        std::pmr::memory_resource* memory;
+
+        RenderGraphContext context;
+        RenderGraphVector<RenderGraphRecord> records;
+        RenderGraphVector<RenderGraphResource> resources;
+        RenderGraphVector<uint32_t> schedule;
+
+        RenderGraphResource& GetResource(RenderGraphResourceHandleBase handle)
+        {
+            assert(handle.GetId() < resources.size());
+
+            return resources[handle.GetId()];
+        }
+
+        template<typename Command, typename Allocator>
+        void Prepare(RenderGraphRecord& record, Command& command, Allocator& allocator)
+        {
+            for (auto handle : record.allocates)
+            {
+                auto& resource = GetResource(handle);
+
+                resource.Allocate(&allocator);
+            }
+
+            for (auto& access: record.reads)
+            {
+                auto& resource = GetResource(access.GetHandle());
+
+                access.BeforeRead(&command, resource);
+            }
+
+            for (auto& access: record.writes)
+            {
+                auto& resource = GetResource(access.GetHandle());
+
+                access.BeforeWrite(&command, resource);
+            }
+
+            if constexpr (requires { command.GetPendingBarrierCount(); })
+            {
+                record.barriers = command.GetPendingBarrierCount();
+            }
+        }
+
+        template<typename Allocator>
+        void Release(RenderGraphRecord& record, Allocator& allocator)
+        {
+            for (auto handle : record.frees)
+            {
+                auto& resource = GetResource(handle);
+
+                resource.Free(&allocator);
+            }
+        }
+
+        void BuildDependencies()
+        {
+            // Readers since the last write of every resource, kept as linked lists in one flat vector
+            struct ReaderNode
+            {
+                uint32_t record;
+                uint32_t next;
+            };
+
+            RenderGraphVector<uint32_t> writers(resources.size(), none, memory);
+            RenderGraphVector<uint32_t> readers(resources.size(), none, memory);
+            RenderGraphVector<ReaderNode> nodes(memory);
 
-                for (auto& access: record.writes)
+            auto depend = [](RenderGraphRecord& record, uint32_t self, uint32_t other) {
+                if (other == none || other == self || std::ranges::find(record.dependencies, other) != record.dependencies.end())
                 {
-                    auto& resource = GetResource(access.GetHandle());
+                    return;
+                }
+
+                record.dependencies.push_back(other);
+            };
+
+            for (uint32_t index = 0; index < records.size(); index++)
+            {
+                auto& record = records[index];
+                record.dependencies.clear();
 
-                    access.BeforeWrite(&command, resource);
+                for (auto handle : record.allocates)
+                {
+                    writers[handle.GetId()] = index;
                 }
 
-                command.BeginPass();
+                for (auto& access : record.reads)
+                {
+                    auto id = access.GetHandle().GetId();
 
-                record.pass->Render(&command);
+                    depend(record, index, writers[id]);
 
-                command.EndPass();
+                    nodes.push_back({ index, readers[id] });
+                    readers[id] = static_cast<uint32_t>(nodes.size() - 1);
+                }
 
-                for (auto& resource : resources)
+                for (auto& access : record.writes)
                 {
-                    if (resource.GetLastRecord() == &record && resource.GetType() == RenderGraphResource::Type::Transient)
+                    auto id = access.GetHandle().GetId();
+
+                    depend(record, index, writers[id]);
+
+                    for (auto node = readers[id]; node != none; node = nodes[node].next)
                     {
-                        resource.Free(&allocator);
+                        depend(record, index, nodes[node].record);
                     }
+
+                    writers[id] = index;
+                    readers[id] = none;
                 }
             }
         }
 
-        RenderGraphContext& GetContext()
+        void BuildLifetimes()
         {
-            return context;
+            RenderGraphVector<uint32_t> last(resources.size(), none, memory);
+
+            for (auto& record : records)
+            {
+                record.frees.clear();
+            }
+
+            for (auto index : schedule)
+            {
+                auto& record = records[index];
+
+                for (auto handle : record.allocates)
+                {
+                    last[handle.GetId()] = index;
+                }
+
+                for (auto& access : record.reads)
+                {
+                    last[access.GetHandle().GetId()] = index;
+                }
+
+                for (auto& access : record.writes)
+                {
+                    last[access.GetHandle().GetId()] = index;
+                }
+            }
+
+            for (uint32_t id = 0; id < resources.size(); id++)
+            {
+                if (last[id] == none || resources[id].GetType() != RenderGraphResource::Type::Transient)
+                {
+                    continue;
+                }
+
+                records[last[id]].frees.emplace_back(id);
+            }
+
+            BuildWriteOps(last);
         }
 
-    private:
-        RenderGraphContext context;
-        std::vector<RenderGraphRecord> records;
-        std::vector<RenderGraphResource> resources;
+        // A write keeps the previous contents only if an earlier pass produced them or the pass reads them itself,
+        // and only stores its result if a later pass touches the resource or it is visible outside the graph
+        void BuildWriteOps(const RenderGraphVector<uint32_t>& last)
+        {
+            RenderGraphVector<bool> written(resources.size(), false, memory);
 
-        RenderGraphResource& GetResource(RenderGraphResourceHandleBase handle)
+            for (auto index : schedule)
+            {
+                auto& record = records[index];
+
+                for (auto& access : record.writes)
+                {
+                    auto id = access.GetHandle().GetId();
+
+                    auto reads = std::ranges::any_of(record.reads, [&](const auto& read) {
+                        return read.GetHandle().GetId() == id;
+                    });
+
+                    RenderGraphWriteOps ops;
+
+                    ops.load = written[id] || reads ? RenderGraphLoadOp::Load : RenderGraphLoadOp::Clear;
+                    ops.store = last[id] != index || resources[id].GetType() == RenderGraphResource::Type::Imported
+                        ? RenderGraphStoreOp::Store
+                        : RenderGraphStoreOp::DontCare;
+
+                    access.SetWriteOps(ops);
+                }
+
+                for (auto& access : record.writes)
+                {
+                    written[access.GetHandle().GetId()] = true;
+                }
+            }
+        }
+
+        // Dependencies always point to earlier records, so a post-order walk yields a valid execution order
+        void Schedule(uint32_t index, RenderGraphVector<bool>& visited)
         {
-            assert(handle.GetId() <= resources.size());
+            if (visited[index])
+            {
+                return;
+            }
 
-            return resources[handle.GetId()];
+            visited[index] = true;
+
+            for (auto dependency : records[index].dependencies)
+            {
+                Schedule(dependency, visited);
+            }
+
+            schedule.push_back(index);
         }
     };
 }
\ No newline at end of file
@@ -10,13 +10,14 @@ namespace Engine
     class RenderGraphBuilder
     {
     public:
-        explicit RenderGraphBuilder(std::vector<RenderGraphResource>& resources) : resources(resources) {}
+        RenderGraphBuilder(RenderGraphVector<RenderGraphResource>& resources, std::pmr::memory_resource* memory)
+            : resources(resources), memory(memory), allocates(memory), reads(memory), writes(memory) {}
 
         template <typename T>
-        RenderGraphResourceHandle<T> Allocate(const typename T::Descriptor& desc)
+        RenderGraphResourceHandle<T> Allocate(const typename T::Descriptor& desc, std::string_view name = {})
         {
             auto handle = RenderGraphResourceHandle<T>(resources.size());
-            resources.emplace_back(RenderGraphResource::Type::Transient, T{}, desc);
+            resources.emplace_back(memory, RenderGraphResource::Type::Transient, T{}, desc, name);
 
             allocates.push_back(handle);
             return handle;
@@ -25,21 +26,22 @@ namespace Engine
         template <typename T>
         void Read(RenderGraphResourceHandle<T> handle, const typename T::AccessInfo& info = {})
         {
-            reads.emplace_back(handle, info);
+            reads.emplace_back(memory, handle, info);
         }
 
         template <typename T>
         void Write(RenderGraphResourceHandle<T> handle, const typename T::AccessInfo& info = {})
         {
-            writes.emplace_back(handle, info);
+            writes.emplace_back(memory, handle, info);
         }
 
     private:
-        std::vector<RenderGraphResource>& resources;
+        RenderGraphVector<RenderGraphResource>& resources;
+        std::pmr::memory_resource* memory;
 
-        std::vector<RenderGraphResourceHandleBase> allocates;
-        std::vector<RenderGraphResourceAccess> reads;
-        std::vector<RenderGraphResourceAccess> writes;
+        RenderGraphVector<RenderGraphResourceHandleBase> allocates;
+        RenderGraphVector<RenderGraphResourceAccess> reads;
+        RenderGraphVector<RenderGraphResourceAccess> writes;
 
         friend class RenderGraph;
     };
@@ -1,19 +1,28 @@
 #pragma once
 
 #include <typeindex>
-#include <any>
+
+#include "RenderGraphMemory.h"
 
 namespace Engine
 {
     class RenderGraphContext
     {
     public:
+        explicit RenderGraphContext(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+            : memory(memory), storage(memory) {}
+
         template<typename T, typename... Args>
-        decltype(auto) Add(Args&& ...args)
+        T& Add(Args&& ...args)
         {
             assert(!Has<T>());
 
-            return storage[typeid(T)].emplace<T>(T{ std::forward<Args>(args)... });
+            auto entry = MakeRenderGraphPtr<Entry, Model<T>>(memory, std::forward<Args>(args)...);
+            auto& value = static_cast<Model<T>*>(entry.get())->value;
+
+            storage.emplace(typeid(T), std::move(entry));
+
+            return value;
         }
 
         template<typename T>
@@ -21,7 +30,7 @@ namespace Engine
         {
             assert(Has<T>());
 
-            return std::any_cast<T&>(storage.at(typeid(T)));
+            return static_cast<Model<T>&>(*storage.at(typeid(T))).value;
         }
 
         template <typename T>
@@ -30,6 +39,21 @@ namespace Engine
         }
 
     private:
-        std::unordered_map<std::type_index, std::any> storage;
+        struct Entry
+        {
+            virtual ~Entry() = default;
+        };
+
+        template<typename T>
+        struct Model final : Entry
+        {
+            template<typename... Args>
+            explicit Model(Args&& ...args) : value{ std::forward<Args>(args)... } { }
+
+            T value;
+        };
+
+        std::pmr::memory_resource* memory;
+        std::pmr::unordered_map<std::type_index, RenderGraphPtr<Entry>> storage;
     };
-}
\ No newline at end of file
+}
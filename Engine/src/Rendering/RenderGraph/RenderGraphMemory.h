@@ -0,0 +1,36 @@
+#pragma once
+
+namespace Engine
+{
+    template<typename T>
+    using RenderGraphVector = std::pmr::vector<T>;
+
+    // Destroys an object placed in a memory resource through a pointer to its base
+    struct RenderGraphDeleter
+    {
+        std::pmr::memory_resource* memory{ nullptr };
+        size_t size{ 0 };
+        size_t alignment{ 0 };
+
+        template<typename T>
+        void operator()(T* object) const
+        {
+            object->~T();
+            memory->deallocate(object, size, alignment);
+        }
+    };
+
+    template<typename T>
+    using RenderGraphPtr = std::unique_ptr<T, RenderGraphDeleter>;
+
+    template<typename Base, typename T, typename... Args>
+    RenderGraphPtr<Base> MakeRenderGraphPtr(std::pmr::memory_resource* memory, Args&&... args)
+    {
+        static_assert(std::has_virtual_destructor_v<Base>);
+
+        auto* storage = memory->allocate(sizeof(T), alignof(T));
+        auto* object = new (storage) T(std::forward<Args>(args)...);
+
+        return RenderGraphPtr<Base>(object, RenderGraphDeleter{ memory, sizeof(T), alignof(T) });
+    }
+}
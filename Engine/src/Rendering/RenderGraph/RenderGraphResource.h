@@ -1,11 +1,32 @@
 #pragma once
 
+#include "RenderGraphMemory.h"
+
 namespace Engine
 {
     class RenderGraphAllocator;
     class RenderGraphCommand;
 
-    struct RenderGraphRecord;
+    enum class RenderGraphLoadOp
+    {
+        Clear,
+        Load,
+        DontCare,
+    };
+
+    enum class RenderGraphStoreOp
+    {
+        Store,
+        DontCare,
+    };
+
+    struct RenderGraphWriteOps
+    {
+        RenderGraphLoadOp load{ RenderGraphLoadOp::Clear };
+        RenderGraphStoreOp store{ RenderGraphStoreOp::Store };
+
+        bool operator==(RenderGraphWriteOps const&) const = default;
+    };
 
     class RenderGraphResourceHandleBase
     {
@@ -33,8 +54,8 @@ namespace Engine
         enum class Type { Imported, Transient };
 
         template<typename T>
-        RenderGraphResource(Type type, T&& resource, const typename T::Descriptor& descriptor)
-            : type(type), impl(std::make_unique<Model<T>>(std::forward<T>(resource), descriptor)) { }
+        RenderGraphResource(std::pmr::memory_resource* memory, Type type, T&& resource, const typename T::Descriptor& descriptor, std::string_view name = {})
+            : type(type), name(name, memory), impl(MakeRenderGraphPtr<Concept, Model<T>>(memory, std::forward<T>(resource), descriptor)) { }
 
         void Allocate(void* allocator) const
         {
@@ -51,15 +72,27 @@ namespace Engine
             impl->BeforeRead(command, info);
         }
 
-        void BeforeWrite(void* command, void* info) const
+        void BeforeWrite(void* command, void* info, const RenderGraphWriteOps& ops) const
         {
-            impl->BeforeWrite(command, info);
+            impl->BeforeWrite(command, info, ops);
         }
 
-        Type GetType() const { return type; }
+        template<typename T>
+        void Rebind(T&& resource)
+        {
+            assert(type == Type::Imported);
 
-        void SetLastRecord(RenderGraphRecord* last) { this->last = last; }
-        RenderGraphRecord* GetLastRecord() const { return last; }
+            static_cast<Model<T>*>(impl.get())->Rebind(std::forward<T>(resource));
+        }
+
+        // Human readable summary of the descriptor, for resources whose descriptor has a Describe overload
+        std::string GetDescription() const
+        {
+            return impl->GetDescription();
+        }
+
+        Type GetType() const { return type; }
+        std::string_view GetName() const { return name; }
 
     private:
         struct Concept
@@ -68,7 +101,8 @@ namespace Engine
             virtual void Allocate(void* allocator) = 0;
             virtual void Free(void* allocator) = 0;
             virtual void BeforeRead(void* command, void* info) = 0;
-            virtual void BeforeWrite(void* command, void* info) = 0;
+            virtual void BeforeWrite(void* command, void* info, const RenderGraphWriteOps& ops) = 0;
+            virtual std::string GetDescription() const = 0;
         };
 
         template<typename T>
@@ -99,12 +133,29 @@ namespace Engine
                 typedCommand->BeforeRead(resource, descriptor, *typedInfo);
             }
 
-            void BeforeWrite(void *command, void *info) override
+            void BeforeWrite(void *command, void *info, const RenderGraphWriteOps& ops) override
             {
                 auto typedCommand = static_cast<typename T::Command*>(command);
                 auto typedInfo = static_cast<typename T::AccessInfo*>(info);
 
-                typedCommand->BeforeWrite(resource, descriptor, *typedInfo);
+                typedCommand->BeforeWrite(resource, descriptor, *typedInfo, ops);
+            }
+
+            std::string GetDescription() const override
+            {
+                if constexpr (requires { Describe(descriptor); })
+                {
+                    return Describe(descriptor);
+                }
+                else
+                {
+                    return {};
+                }
+            }
+
+            void Rebind(T&& resource)
+            {
+                this->resource = std::forward<T>(resource);
             }
 
         private:
@@ -113,16 +164,16 @@ namespace Engine
         };
 
         Type type;
-        RenderGraphRecord* last{ nullptr };
-        std::unique_ptr<Concept> impl{ nullptr };
+        std::pmr::string name;
+        RenderGraphPtr<Concept> impl{ nullptr };
     };
 
     class RenderGraphResourceAccess final
     {
     public:
         template<typename AccessInfo>
-        RenderGraphResourceAccess(const RenderGraphResourceHandleBase handle, const AccessInfo& info)
-            : handle(handle), impl(std::make_unique<Model<AccessInfo>>(info)) { }
+        RenderGraphResourceAccess(std::pmr::memory_resource* memory, const RenderGraphResourceHandleBase handle, const AccessInfo& info)
+            : handle(handle), impl(MakeRenderGraphPtr<Concept, Model<AccessInfo>>(memory, info)) { }
 
         void BeforeRead(void* command, RenderGraphResource& resource) const
         {
@@ -131,17 +182,20 @@ namespace Engine
 
         void BeforeWrite(void* command, RenderGraphResource& resource) const
         {
-            impl->BeforeWrite(command, resource);
+            impl->BeforeWrite(command, resource, ops);
         }
 
         RenderGraphResourceHandleBase GetHandle() const { return handle; }
 
+        void SetWriteOps(const RenderGraphWriteOps& ops) { this->ops = ops; }
+        const RenderGraphWriteOps& GetWriteOps() const { return ops; }
+
     private:
         struct Concept
         {
             virtual ~Concept() = default;
             virtual void BeforeRead(void* command, RenderGraphResource& resource) = 0;
-            virtual void BeforeWrite(void* command, RenderGraphResource& resource) = 0;
+            virtual void BeforeWrite(void* command, RenderGraphResource& resource, const RenderGraphWriteOps& ops) = 0;
         };
 
         template<typename AccessInfo>
@@ -154,9 +208,9 @@ namespace Engine
                 resource.BeforeRead(command, &info);
             }
 
-            void BeforeWrite(void *command, RenderGraphResource &resource) override
+            void BeforeWrite(void *command, RenderGraphResource &resource, const RenderGraphWriteOps& ops) override
             {
-                resource.BeforeWrite(command, &info);
+                resource.BeforeWrite(command, &info, ops);
             }
 
         private:
@@ -164,6 +218,7 @@ namespace Engine
         };
 
         RenderGraphResourceHandleBase handle;
-        std::unique_ptr<Concept> impl{ nullptr };
+        RenderGraphWriteOps ops{};
+        RenderGraphPtr<Concept> impl{ nullptr };
     };
 };
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "RenderGraphSnapshot.h"
+
+namespace Engine
+{
+    std::string Escape(std::string_view text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+
+        for (auto character : text)
+        {
+            switch (character)
+            {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            default:
+                escaped += character;
+                break;
+            }
+        }
+
+        return escaped;
+    }
+
+    const char* LoadOpToString(RenderGraphLoadOp op)
+    {
+        switch (op)
+        {
+        case RenderGraphLoadOp::Clear:
+            return "Clear";
+        case RenderGraphLoadOp::Load:
+            return "Load";
+        case RenderGraphLoadOp::DontCare:
+            return "DontCare";
+        }
+
+        return "";
+    }
+
+    const char* StoreOpToString(RenderGraphStoreOp op)
+    {
+        switch (op)
+        {
+        case RenderGraphStoreOp::Store:
+            return "Store";
+        case RenderGraphStoreOp::DontCare:
+            return "DontCare";
+        }
+
+        return "";
+    }
+
+    double ToMilliseconds(std::chrono::nanoseconds time)
+    {
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+
+    std::chrono::nanoseconds RenderGraphSnapshot::GetRecordTime() const
+    {
+        std::chrono::nanoseconds total{ 0 };
+
+        for (const auto& pass : passes)
+        {
+            total += pass.recordTime;
+        }
+
+        return total;
+    }
+
+    // Passes are boxes and resources ellipses, culled passes and the resources only they touch are greyed out
+    void WriteDot(const RenderGraphSnapshot& snapshot, std::ostream& stream)
+    {
+        stream << "digraph RenderGraph {\n";
+        stream << "    rankdir=LR;\n";
+        stream << "    node [fontname=\"Helvetica\", fontsize=10];\n";
+        stream << "    edge [fontname=\"Helvetica\", fontsize=8];\n";
+
+        for (uint32_t index = 0; index < snapshot.passes.size(); index++)
+        {
+            const auto& pass = snapshot.passes[index];
+
+            stream << "    pass" << index << " [shape=box, label=\"" << Escape(pass.name);
+
+            if (pass.IsCulled())
+            {
+                stream << "\\nculled\", style=dashed, color=gray, fontcolor=gray];\n";
+                continue;
+            }
+
+            stream << "\\n#" << pass.order << "  " << ToMilliseconds(pass.recordTime) << " ms  "
+                   << pass.barriers << " barriers\", style=filled, fillcolor=lightblue];\n";
+        }
+
+        for (uint32_t index = 0; index < snapshot.resources.size(); index++)
+        {
+            const auto& resource = snapshot.resources[index];
+
+            stream << "    resource" << index << " [shape=" << (resource.imported ? "doubleoctagon" : "ellipse")
+                   << ", label=\"" << Escape(resource.name);
+
+            if (!resource.description.empty())
+            {
+                stream << "\\n" << Escape(resource.description);
+            }
+
+            if (resource.first == RenderGraphSnapshot::none)
+            {
+                stream << "\", style=dashed, color=gray, fontcolor=gray];\n";
+                continue;
+            }
+
+            stream << "\\nlives " << resource.first << ".." << resource.last << "\"];\n";
+        }
+
+        for (uint32_t index = 0; index < snapshot.passes.size(); index++)
+        {
+            for (const auto& access : snapshot.passes[index].accesses)
+            {
+                if (access.write)
+                {
+                    stream << "    pass" << index << " -> resource" << access.resource
+                           << " [label=\"" << LoadOpToString(access.ops.load) << "/" << StoreOpToString(access.ops.store) << "\"];\n";
+                }
+                else
+                {
+                    stream << "    resource" << access.resource << " -> pass" << index << ";\n";
+                }
+            }
+        }
+
+        stream << "}\n";
+    }
+
+    void WriteJson(const RenderGraphSnapshot& snapshot, std::ostream& stream)
+    {
+        auto position = [&](uint32_t value) -> std::ostream& {
+            if (value == RenderGraphSnapshot::none)
+            {
+                return stream << "null";
+            }
+
+            return stream << value;
+        };
+
+        stream << "{\n    \"recordTimeNs\": " << snapshot.GetRecordTime().count() << ",\n";
+        stream << "    \"passes\": [";
+
+        for (uint32_t index = 0; index < snapshot.passes.size(); index++)
+        {
+            const auto& pass = snapshot.passes[index];
+
+            stream << (index ? ",\n" : "\n") << "        { \"name\": \"" << Escape(pass.name) << "\", \"order\": ";
+            position(pass.order) << ", \"culled\": " << (pass.IsCulled() ? "true" : "false")
+                << ", \"barriers\": " << pass.barriers
+                << ", \"recordTimeNs\": " << pass.recordTime.count()
+                << ", \"dependencies\": [";
+
+            for (uint32_t dependency = 0; dependency < pass.dependencies.size(); dependency++)
+            {
+                stream << (dependency ? ", " : "") << pass.dependencies[dependency];
+            }
+
+            stream << "], \"accesses\": [";
+
+            for (uint32_t access = 0; access < pass.accesses.size(); access++)
+            {
+                const auto& info = pass.accesses[access];
+
+                stream << (access ? ", " : "") << "{ \"resource\": " << info.resource
+                       << ", \"write\": " << (info.write ? "true" : "false");
+
+                if (info.write)
+                {
+                    stream << ", \"load\": \"" << LoadOpToString(info.ops.load) << "\", \"store\": \"" << StoreOpToString(info.ops.store) << "\"";
+                }
+
+                stream << " }";
+            }
+
+            stream << "] }";
+        }
+
+        stream << "\n    ],\n    \"resources\": [";
+
+        for (uint32_t index = 0; index < snapshot.resources.size(); index++)
+        {
+            const auto& resource = snapshot.resources[index];
+
+            stream << (index ? ",\n" : "\n") << "        { \"name\": \"" << Escape(resource.name)
+                   << "\", \"description\": \"" << Escape(resource.description)
+                   << "\", \"imported\": " << (resource.imported ? "true" : "false")
+                   << ", \"first\": ";
+            position(resource.first) << ", \"last\": ";
+            position(resource.last) << " }";
+        }
+
+        stream << "\n    ]\n}\n";
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "RenderGraphResource.h"
+
+namespace Engine
+{
+    // A copy of what a compiled graph looks like and what its last execution did, which outlives the graph arena
+    struct RenderGraphSnapshot
+    {
+        static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+        struct Access
+        {
+            uint32_t resource{ 0 };
+            bool write{ false };
+            RenderGraphWriteOps ops{};
+        };
+
+        struct Pass
+        {
+            std::string name;
+
+            // Position in the schedule, none for culled passes
+            uint32_t order{ none };
+            std::vector<uint32_t> dependencies;
+            std::vector<Access> accesses;
+
+            // Barriers the command had to emit before the pass, and the CPU time spent recording it
+            uint32_t barriers{ 0 };
+            std::chrono::nanoseconds recordTime{ 0 };
+
+            [[nodiscard]] bool IsCulled() const { return order == none; }
+        };
+
+        struct Resource
+        {
+            std::string name;
+            std::string description;
+            bool imported{ false };
+
+            // Schedule positions of the first and last pass touching the resource, none if only culled passes do
+            uint32_t first{ none };
+            uint32_t last{ none };
+        };
+
+        std::vector<Pass> passes;
+        std::vector<Resource> resources;
+
+        [[nodiscard]] std::chrono::nanoseconds GetRecordTime() const;
+    };
+
+    void WriteDot(const RenderGraphSnapshot& snapshot, std::ostream& stream);
+    void WriteJson(const RenderGraphSnapshot& snapshot, std::ostream& stream);
+}
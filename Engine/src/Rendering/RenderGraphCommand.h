@@ -3,6 +3,8 @@
 #include "RenderBuffer.h"
 #include "RenderTexture.h"
 
+#include "RenderGraph/RenderGraphResource.h"
+
 namespace Engine
 {
     enum class RenderGeometryType
@@ -17,11 +19,19 @@ namespace Engine
         std::string_view shader;
     };
 
+    enum class ShadowCasters
+    {
+        // Every caster, or only the moving ones when static casters are cached
+        Dynamic,
+        Static
+    };
+
     struct DrawShadowSettings
     {
         glm::vec3 lightDirection{};
         float depthBias{};
         float normalBias{};
+        ShadowCasters casters{ ShadowCasters::Dynamic };
     };
 
     class RenderGraphCommand
@@ -30,10 +40,10 @@ namespace Engine
         virtual ~RenderGraphCommand() = default;
 
         virtual void BeforeRead(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info) = 0;
-        virtual void BeforeWrite(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info) = 0;
+        virtual void BeforeWrite(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info, const RenderGraphWriteOps& ops) = 0;
 
         virtual void BeforeRead(const RenderBuffer& buffer, const RenderBufferDesc& dec, const RenderBufferAccessInfo& info) = 0;
-        virtual void BeforeWrite(const RenderBuffer& buffer, const RenderBufferDesc& dec, const RenderBufferAccessInfo& info) = 0;
+        virtual void BeforeWrite(const RenderBuffer& buffer, const RenderBufferDesc& dec, const RenderBufferAccessInfo& info, const RenderGraphWriteOps& ops) = 0;
 
         virtual void BeginPass() = 0;
         virtual void EndPass() = 0;
@@ -1 +1,42 @@
 #include "RenderTexture.h"
+
+namespace Engine
+{
+    std::string Describe(const RenderTextureDesc& desc)
+    {
+        auto description = std::to_string(desc.width) + "x" + std::to_string(desc.height);
+
+        switch (desc.format)
+        {
+        case RenderTextureFormat::Linear:
+            description += " Linear";
+            break;
+        case RenderTextureFormat::sRGB:
+            description += " sRGB";
+            break;
+        case RenderTextureFormat::HDR:
+            description += " HDR";
+            break;
+        case RenderTextureFormat::Depth:
+            description += " Depth";
+            break;
+        }
+
+        if (bool(desc.usage & RenderTextureUsage::RenderTarget))
+        {
+            description += " RenderTarget";
+        }
+
+        if (bool(desc.usage & RenderTextureUsage::Sampled))
+        {
+            description += " Sampled";
+        }
+
+        if (bool(desc.usage & RenderTextureUsage::Transfer))
+        {
+            description += " Transfer";
+        }
+
+        return description;
+    }
+}
@@ -40,6 +40,7 @@ namespace Engine
         VertexShader = 1 << 0,
         FragmentShader = 1 << 1,
         ComputeShader = 1 << 2,
+        DrawIndirect = 1 << 3,
     };
     template <> struct has_flags<RenderGraphPipelineStage> : std::true_type {};
 
@@ -79,6 +80,8 @@ namespace Engine
         bool operator==(RenderTextureDesc const&) const = default;
     };
 
+    std::string Describe(const RenderTextureDesc& desc);
+
     struct RenderTextureAccessInfo
     {
         RenderTextureAccessType type{ RenderTextureAccessType::Attachment };
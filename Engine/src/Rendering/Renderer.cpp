@@ -17,7 +17,9 @@ namespace Engine
 	Renderer::Renderer(RenderContext& renderContext)
 		: renderContext(renderContext)
 	{
-		allocator = std::make_unique<VulkanRenderGraphAllocator>(renderContext.GetDevice());
+		settings.transientMemory.framesInFlight = renderContext.GetFrameCount();
+
+		allocator = std::make_unique<VulkanRenderGraphAllocator>(renderContext.GetDevice(), settings.transientMemory);
 
 		VkSamplerCreateInfo point{ VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
 		point.magFilter = VK_FILTER_NEAREST;
@@ -48,36 +50,158 @@ namespace Engine
 
 	Renderer::~Renderer()
 	{
+		frameGraphs.clear();
+		staticShadowMap.reset();
 		allocator.reset();
 		samplers.clear();
 	}
 
 	void Renderer::Draw(Vulkan::CommandBuffer& commandBuffer, Scene& scene, RenderCamera& camera, RenderAttachment& target)
 	{
-		RenderBatcher batcher;
-		batcher.BuildBatches(scene, camera);
+		batcher.SetShadowSettings(settings.shadow);
 
-		const auto [width, height] = target.GetExtent();
+		if (settings.parallelBatching)
+		{
+			batcher.BuildBatches(scene, camera, renderContext.GetThreadPool());
+		}
+		else
+		{
+			batcher.BuildBatches(scene, camera);
+		}
+
+		auto& frame = renderContext.GetCurrentFrame();
+
+		allocator->BeginFrame();
+
+		frameGraphs.resize(std::max<size_t>(frameGraphs.size(), renderContext.GetFrameCount()));
+
+		auto& frameGraph = frameGraphs[renderContext.GetCurrentFrameIndex()];
+
+		// The cached shadow map is only redrawn on frames the static casters changed, which is a different graph
+		const auto cacheStaticShadows = settings.shadow.mode == ShadowMode::CachedStatic;
+		const auto renderStaticShadows = cacheStaticShadows && batcher.HasStaticShadowChanges();
+
+		const auto key = GetGraphKey(scene, target, renderStaticShadows);
+		const auto rebuild = !frameGraph.graph || frameGraph.stale || key != frameGraph.key;
+
+		if (rebuild)
+		{
+			frameGraph.graph.reset();
+
+			auto& arena = frame.GetGraphArena();
+			arena.Reset();
+
+			frameGraph.graph.emplace(&arena);
+			frameGraph.key = key;
+			frameGraph.stale = false;
+		}
 
-		RenderGraph graph;
+		auto& graph = *frameGraph.graph;
 		auto& graphContext = graph.GetContext();
 
 		ImportFrameData(graph, graphContext, camera);
 		ImportBackBufferData(graph, graphContext, target);
 		ImportLightsData(graph, graphContext, scene);
 
-		ShadowPass shadowPass{ scene, settings.shadow };
-		ForwardPass forwardPass{ scene, { width, height } };
-		CompositionPass compositionPass;
+		if (cacheStaticShadows)
+		{
+			ImportStaticShadowData(graph, graphContext);
+		}
+
+		if (rebuild)
+		{
+			BuildGraph(frameGraph, scene, target, renderStaticShadows);
+		}
+
+		const auto& instances = batcher.GetInstances();
+
+		auto instanceAllocation = frame.RequestBufferAllocation(
+			Vulkan::BufferUsageFlags::Vertex,
+			static_cast<uint32_t>(instances.size() * sizeof(glm::mat4))
+		);
+
+		instanceAllocation.SetData((void*)instances.data());
 
-		graph.AddPass(shadowPass);
-		graph.AddPass(forwardPass);
-		graph.AddPass(compositionPass);
+		const auto& drawCommands = batcher.GetDrawCommands();
+
+		auto drawCommandAllocation = frame.RequestBufferAllocation(
+			Vulkan::BufferUsageFlags::Indirect,
+			static_cast<uint32_t>(drawCommands.size() * sizeof(VkDrawIndexedIndirectCommand))
+		);
+
+		drawCommandAllocation.SetData((void*)drawCommands.data());
+
+		VulkanRenderGraphCommand command{ renderContext, batcher, shaderCache, commandBuffer, samplers, instanceAllocation, drawCommandAllocation };
+
+		if (settings.parallelRecording)
+		{
+			graph.Execute(command, *allocator, renderContext.GetThreadPool());
+		}
+		else
+		{
+			graph.Execute(command, *allocator);
+		}
+
+		lastFrameGraph = renderContext.GetCurrentFrameIndex();
+	}
+
+	RenderGraphSnapshot Renderer::GetGraphSnapshot() const
+	{
+		if (lastFrameGraph >= frameGraphs.size() || !frameGraphs[lastFrameGraph].graph)
+		{
+			return {};
+		}
+
+		return frameGraphs[lastFrameGraph].graph->GetSnapshot();
+	}
+
+	VulkanRenderGraphAllocatorStats Renderer::GetTransientMemoryStats() const
+	{
+		return allocator->GetStats();
+	}
+
+	void Renderer::BuildGraph(FrameGraph& frameGraph, Scene& scene, RenderAttachment& target, bool renderStaticShadows)
+	{
+		const auto [width, height] = target.GetExtent();
+
+		frameGraph.staticShadowPass = renderStaticShadows ? std::make_unique<StaticShadowPass>(scene, settings.shadow) : nullptr;
+		frameGraph.shadowPass = std::make_unique<ShadowPass>(scene, settings.shadow);
+		frameGraph.forwardPass = std::make_unique<ForwardPass>(scene, ResolutionSettings{ width, height });
+		frameGraph.compositionPass = std::make_unique<CompositionPass>();
+
+		auto& graph = *frameGraph.graph;
+
+		if (frameGraph.staticShadowPass)
+		{
+			graph.AddPass(*frameGraph.staticShadowPass, "StaticShadow");
+		}
+
+		graph.AddPass(*frameGraph.shadowPass, "Shadow");
+		graph.AddPass(*frameGraph.forwardPass, "Forward");
+		graph.AddPass(*frameGraph.compositionPass, "Composition");
 
 		graph.Compile();
+	}
+
+	void Renderer::InvalidateGraphs()
+	{
+		for (auto& frameGraph : frameGraphs)
+		{
+			frameGraph.stale = true;
+		}
+	}
+
+	// Everything the graph structure depends on, a change in any of these rebuilds it
+	size_t Renderer::GetGraphKey(Scene& scene, RenderAttachment& target, bool renderStaticShadows) const
+	{
+		const auto [width, height] = target.GetExtent();
+
+		size_t hash{ 0 };
 
-		VulkanRenderGraphCommand command{ renderContext, batcher, shaderCache, commandBuffer, samplers };
-		graph.Execute(command, *allocator);
+		// The scene's address survives assigning another scene to it, its generation doesn't
+		Hash(hash, &scene, scene.GetGeneration(), width, height, settings.shadow.mode, renderStaticShadows);
+
+		return hash;
 	}
 
 	struct CameraUniform
@@ -102,15 +226,28 @@ namespace Engine
 
 		allocation.SetData(&cameraUniform);
 
+		if (context.Has<FrameData>())
+		{
+			graph.Rebind(context.Get<FrameData>().camera, { allocation });
+			return;
+		}
+
 		auto& frameData = context.Add<FrameData>();
 		frameData.camera = graph.Import<RenderBuffer>(
 			{ allocation },
-			{ sizeof(CameraUniform) }
+			{ sizeof(CameraUniform) },
+			"Camera"
 		);
 	}
 
 	void Renderer::ImportBackBufferData(RenderGraph& graph, RenderGraphContext& context, RenderAttachment &target) const
 	{
+		if (context.Has<BackBufferData>())
+		{
+			graph.Rebind(context.Get<BackBufferData>().target, { &target });
+			return;
+		}
+
 		auto& backBufferData = context.Add<BackBufferData>();
 		backBufferData.target = graph.Import<RenderTexture>(
 			{ &target },
@@ -119,7 +256,38 @@ namespace Engine
 				.height = target.GetExtent().height,
 				.format = RenderTextureFormat::Linear,
 				.usage = RenderTextureUsage::RenderTarget
-			}
+			},
+			"BackBuffer"
+		);
+	}
+
+	void Renderer::ImportStaticShadowData(RenderGraph& graph, RenderGraphContext& context)
+	{
+		if (!staticShadowMap)
+		{
+			staticShadowMap = RenderAttachment::Builder(renderContext.GetDevice())
+				.Extent({ shadowMapResolution, shadowMapResolution })
+				.Usage(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
+				.Format(VK_FORMAT_D16_UNORM)
+				.Build();
+		}
+
+		if (context.Has<StaticShadowData>())
+		{
+			graph.Rebind(context.Get<StaticShadowData>().shadowMap, { staticShadowMap.get() });
+			return;
+		}
+
+		auto& staticShadowData = context.Add<StaticShadowData>();
+		staticShadowData.shadowMap = graph.Import<RenderTexture>(
+			{ staticShadowMap.get() },
+			{
+				.width = shadowMapResolution,
+				.height = shadowMapResolution,
+				.format = RenderTextureFormat::Depth,
+				.usage = RenderTextureUsage::RenderTarget | RenderTextureUsage::Sampled
+			},
+			"StaticShadowMap"
 		);
 	}
 
@@ -154,14 +322,8 @@ namespace Engine
 		const auto& [transform, light] = query.GetComponent(entity);
 
 		auto direction = glm::normalize(transform.rotation * glm::vec3{ 0, 0, 1 });
-		auto view = glm::lookAt(-direction, glm::vec3{ 0, 0, 0 }, glm::vec3{ 0, 1, 0 });
-
-		Camera camera;
-		camera.SetOrthographic(50, -25.f, 25.f);
-
-		auto projection = camera.GetProjection();
 
-		shadow.viewProjection = projection * view;
+		shadow.viewProjection = GetShadowViewProjection(direction);
 
 		lights.lights[0].color = { light.color, light.intensity };
 		lights.lights[0].vector = glm::vec4{ direction, 1.f };
@@ -194,33 +356,40 @@ namespace Engine
 		GetMainLightData(scene, lights, shadow);
 		GetAdditionalLightsData(scene, lights);
 
-		auto& lightData = context.Add<LightData>();
-
-		{
-			auto allocation = renderContext
+		auto lightsAllocation = renderContext
 			.GetCurrentFrame()
 			.RequestBufferAllocation(Vulkan::BufferUsageFlags::Uniform, sizeof(LightsUniform));
 
-			allocation.SetData(&lights);
+		lightsAllocation.SetData(&lights);
 
-			lightData.lights = graph.Import<RenderBuffer>(
-				{ allocation },
-				{ sizeof(CameraUniform) }
-			);
-		}
-
-		{
-			auto allocation = renderContext
+		auto shadowAllocation = renderContext
 			.GetCurrentFrame()
 			.RequestBufferAllocation(Vulkan::BufferUsageFlags::Uniform, sizeof(ShadowUniform));
 
-			allocation.SetData(&shadow);
+		shadowAllocation.SetData(&shadow);
 
-			lightData.shadows = graph.Import<RenderBuffer>(
-				{ allocation },
-				{ sizeof(CameraUniform) }
-			);
+		if (context.Has<LightData>())
+		{
+			auto& lightData = context.Get<LightData>();
+
+			graph.Rebind(lightData.lights, { lightsAllocation });
+			graph.Rebind(lightData.shadows, { shadowAllocation });
+			return;
 		}
+
+		auto& lightData = context.Add<LightData>();
+
+		lightData.lights = graph.Import<RenderBuffer>(
+			{ lightsAllocation },
+			{ sizeof(LightsUniform) },
+			"Lights"
+		);
+
+		lightData.shadows = graph.Import<RenderBuffer>(
+			{ shadowAllocation },
+			{ sizeof(ShadowUniform) },
+			"Shadows"
+		);
 	}
 
 
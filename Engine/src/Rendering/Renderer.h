@@ -6,11 +6,13 @@
 #include "Pass/ShadowPass.h"
 #include "Pass/CompositionPass.h"
 
-#include "RenderGraphAllocator.h"
+#include "VulkanRenderGraphAllocator.h"
+#include "RenderGraph/RenderGraph.h"
 
 #include "RenderCamera.h"
 #include "RenderContext.h"
 #include "ShaderCache.h"
+#include "RenderBatcher.h"
 
 namespace Engine
 {
@@ -20,6 +22,12 @@ namespace Engine
 	struct RendererSettings
 	{
 		ShadowSettings shadow;
+		// Records the graph passes on the render context's thread pool instead of the calling thread
+		bool parallelRecording{ true };
+		// Builds the draw batches on the render context's thread pool
+		bool parallelBatching{ true };
+		// Frames in flight are taken from the render context
+		VulkanRenderGraphAllocatorSettings transientMemory;
 	};
 
 	struct BackBufferData
@@ -32,12 +40,32 @@ namespace Engine
 		RenderGraphResourceHandle<RenderBuffer> camera;
 	};
 
+	// Persistent shadow map of the static casters, imported when ShadowMode::CachedStatic is used
+	struct StaticShadowData
+	{
+		RenderGraphResourceHandle<RenderTexture> shadowMap;
+	};
+
 	struct LightData
 	{
 		RenderGraphResourceHandle<RenderBuffer> lights;
 		RenderGraphResourceHandle<RenderBuffer> shadows;
 	};
 
+	// Compiled graph of one frame in flight, allocated from that frame's graph arena
+	struct FrameGraph
+	{
+		std::optional<RenderGraph> graph;
+		size_t key{ 0 };
+		// Rebuilt on the frame's next draw whatever its key, set when the passes may refer to a scene that's gone
+		bool stale{ false };
+
+		std::unique_ptr<StaticShadowPass> staticShadowPass;
+		std::unique_ptr<ShadowPass> shadowPass;
+		std::unique_ptr<ForwardPass> forwardPass;
+		std::unique_ptr<CompositionPass> compositionPass;
+	};
+
 
 	class Renderer
 	{
@@ -46,13 +74,31 @@ namespace Engine
 		~Renderer();
 
 		void Draw(Vulkan::CommandBuffer& commandBuffer, Scene& scene, RenderCamera& camera, RenderAttachment& target);
+
+		// Has every frame's graph rebuilt on its next draw, called when the drawn scene is replaced
+		void InvalidateGraphs();
+
+		// The graph drawn last, with the pass timings of that draw
+		[[nodiscard]] RenderGraphSnapshot GetGraphSnapshot() const;
+		[[nodiscard]] VulkanRenderGraphAllocatorStats GetTransientMemoryStats() const;
 	private:
+		void BuildGraph(FrameGraph& frameGraph, Scene& scene, RenderAttachment& target, bool renderStaticShadows);
+		size_t GetGraphKey(Scene& scene, RenderAttachment& target, bool renderStaticShadows) const;
+
 		void ImportBackBufferData(RenderGraph& graph, RenderGraphContext& context, RenderAttachment& target) const;
 		void ImportFrameData(RenderGraph& graph, RenderGraphContext& context, RenderCamera& camera) const;
 		void ImportLightsData(RenderGraph& graph, RenderGraphContext& context, Scene& scene) const;
+		void ImportStaticShadowData(RenderGraph& graph, RenderGraphContext& context);
 
 		std::unordered_map<RenderTextureSampler, std::unique_ptr<Vulkan::Sampler>> samplers;
-		std::unique_ptr<RenderGraphAllocator> allocator;
+		std::unique_ptr<VulkanRenderGraphAllocator> allocator;
+		// Created the first time static casters are cached
+		std::unique_ptr<RenderAttachment> staticShadowMap;
+		// Persists between frames so only the entities that changed are refreshed
+		RenderBatcher batcher;
+
+		std::vector<FrameGraph> frameGraphs;
+		size_t lastFrameGraph{ 0 };
 
 		RenderContext& renderContext;
 		ShaderCache shaderCache;
@@ -11,9 +11,19 @@ namespace Engine
         Output,
         ImageSampler,
         BufferUniform,
+        BufferStorage,
         PushConstant
     };
 
+    // Dynamic buffers are written to their descriptor set without an offset, which is given when the set is bound.
+    // Bindless resources are runtime sized arrays living in a global set instead of the frame's descriptor sets.
+    enum class ShaderResourceMode
+    {
+        Static,
+        Dynamic,
+        Bindless
+    };
+
     enum class ShaderStage
     {
         Vertex = 1 << 0,
@@ -34,6 +44,8 @@ namespace Engine
         uint32_t columns;
         uint32_t arraySize;
         uint32_t size;
+
+        ShaderResourceMode mode{ ShaderResourceMode::Static };
     };
 
     class ShaderSource
@@ -33,6 +33,8 @@ namespace Engine
         {
             auto path = std::string{ name } + GetStagePrefix(stage) + ".glsl";
 
+            std::lock_guard lock{ mutex };
+
             auto it = sources.find(path);
 
             if (it != sources.end())
@@ -62,6 +64,8 @@ namespace Engine
         }
 
         std::unordered_map<std::string, ShaderSource> sources;
+        std::mutex mutex;
+
         Cache<ShaderModule> shaders;
     };
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "SortIdPool.h"
+
+namespace Engine
+{
+	SortId SortIdPool::Add()
+	{
+		std::lock_guard lock(mutex);
+
+		const auto index = indices.Allocate(1);
+
+		if (!index)
+		{
+			return {};
+		}
+
+		return { *this, *index };
+	}
+
+	uint32_t SortIdPool::GetIndex(const SortId& id)
+	{
+		return id.IsValid() ? id.GetIndex() : MAX_IDS;
+	}
+
+	uint32_t SortIdPool::GetIdCount()
+	{
+		std::lock_guard lock(mutex);
+
+		return MAX_IDS - indices.GetFreeSize();
+	}
+
+	void SortIdPool::Remove(uint32_t index)
+	{
+		std::lock_guard lock(mutex);
+
+		indices.Free(index, 1);
+	}
+}
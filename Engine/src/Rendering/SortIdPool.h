@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Common/FreeListAllocator.h"
+
+#include "TableSlot.h"
+
+namespace Engine
+{
+	class SortIdPool;
+
+	using SortId = TableSlot<SortIdPool>;
+
+	// Small ids for packing objects into draw sort keys. An id is unique while its owner lives and is reused after,
+	// so unlike a hash of the object's address two live objects never share one.
+	class SortIdPool
+	{
+	public:
+		// Ids fit in 16 bits, the last value is shared by everything added once the pool is exhausted
+		static constexpr uint32_t MAX_IDS = 0xffff;
+
+		// An invalid id once the pool is exhausted, see GetIndex
+		SortId Add();
+
+		// The id's index, or MAX_IDS if the pool had none left for it
+		[[nodiscard]] static uint32_t GetIndex(const SortId& id);
+
+		[[nodiscard]] uint32_t GetIdCount();
+
+	private:
+		friend class TableSlot<SortIdPool>;
+
+		void Remove(uint32_t index);
+
+		std::mutex mutex;
+
+		FreeListAllocator indices{ MAX_IDS };
+	};
+}
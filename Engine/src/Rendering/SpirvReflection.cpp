@@ -93,6 +93,10 @@ namespace Engine
         {
             ShaderResource resource = CreateShaderResource<ShaderResourceType::BufferUniform>(uniform);
 
+            // Uniform buffers are always sub-allocated from the frame's buffer pools, so draws that only move
+            // to another allocation of the same buffer can keep their descriptor set
+            resource.mode = ShaderResourceMode::Dynamic;
+
             ParseResourceArraySize(uniform, resource);
             ParseResourceSize(uniform, resource);
 
@@ -103,6 +107,25 @@ namespace Engine
         }
     }
 
+    template<>
+    void SpirvReflection::ParseShaderResource<ShaderResourceType::BufferStorage>(std::vector<ShaderResource>& shaderResources)
+    {
+        spirv_cross::ShaderResources resources = compiler.get_shader_resources();
+
+        for (auto& storage : resources.storage_buffers)
+        {
+            ShaderResource resource = CreateShaderResource<ShaderResourceType::BufferStorage>(storage);
+
+            ParseResourceArraySize(storage, resource);
+            ParseResourceSize(storage, resource);
+
+            ParseResourceDecoration<spv::DecorationDescriptorSet>(storage, resource);
+            ParseResourceDecoration<spv::DecorationBinding>(storage, resource);
+
+            shaderResources.push_back(resource);
+        }
+    }
+
     template<>
     void SpirvReflection::ParseShaderResource<ShaderResourceType::ImageSampler>(std::vector<ShaderResource>& shaderResources)
     {
@@ -114,6 +137,12 @@ namespace Engine
 
             ParseResourceArraySize(image, resource);
 
+            // Arrays declared without a size are indexed into the texture table
+            if (const auto& type = compiler.get_type_from_variable(image.id); !type.array.empty() && type.array[0] == 0)
+            {
+                resource.mode = ShaderResourceMode::Bindless;
+            }
+
             ParseResourceDecoration<spv::DecorationDescriptorSet>(image, resource);
             ParseResourceDecoration<spv::DecorationBinding>(image, resource);
 
@@ -141,6 +170,7 @@ namespace Engine
         ParseShaderResource<ShaderResourceType::Input>(shaderResources);
         ParseShaderResource<ShaderResourceType::Output>(shaderResources);
         ParseShaderResource<ShaderResourceType::BufferUniform>(shaderResources);
+        ParseShaderResource<ShaderResourceType::BufferStorage>(shaderResources);
         ParseShaderResource<ShaderResourceType::ImageSampler>(shaderResources);
         ParseShaderResource<ShaderResourceType::PushConstant>(shaderResources);
     }
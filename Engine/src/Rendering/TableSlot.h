@@ -0,0 +1,64 @@
+#pragma once
+
+namespace Engine
+{
+	// An index handed out by a GPU side table, given back to the table when destroyed
+	template <typename Table>
+	class TableSlot
+	{
+	public:
+		TableSlot() = default;
+		TableSlot(Table& owner, uint32_t index) : owner(&owner), index(index)
+		{
+		}
+
+		~TableSlot()
+		{
+			Release();
+		}
+
+		TableSlot(TableSlot&& other) noexcept : owner(std::exchange(other.owner, nullptr)), index(other.index)
+		{
+		}
+
+		TableSlot& operator=(TableSlot&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Release();
+
+				owner = std::exchange(other.owner, nullptr);
+				index = other.index;
+			}
+
+			return *this;
+		}
+
+		TableSlot(const TableSlot&) = delete;
+		TableSlot& operator=(const TableSlot&) = delete;
+
+		[[nodiscard]] bool IsValid() const
+		{
+			return owner != nullptr;
+		}
+
+		[[nodiscard]] uint32_t GetIndex() const
+		{
+			return index;
+		}
+
+	private:
+		void Release()
+		{
+			if (owner)
+			{
+				owner->Remove(index);
+			}
+
+			owner = nullptr;
+		}
+
+		Table* owner{ nullptr };
+		uint32_t index{ 0 };
+	};
+}
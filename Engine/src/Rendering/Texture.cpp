@@ -141,6 +141,11 @@ namespace Engine
 		samplerInfo.maxLod = mipmaps.size();
 
 		sampler = std::make_unique<Vulkan::Sampler>(device, samplerInfo);
+
+		if (GetImageViewType() == VK_IMAGE_VIEW_TYPE_2D)
+		{
+			slot = device.GetTextureTable().Add(*imageView, *sampler);
+		}
 	}
 
 	void Texture::PrepareImageBuilder(Vulkan::ImageBuilder& builder)
@@ -185,6 +190,13 @@ namespace Engine
 		return *sampler;
 	}
 
+	uint32_t Texture::GetTextureIndex() const
+	{
+		assert(slot.IsValid());
+
+		return slot.GetIndex();
+	}
+
 	VkExtent3D Texture::GetExtent() const
 	{
 		return mipmaps[0].extent;
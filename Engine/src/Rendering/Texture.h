@@ -9,6 +9,8 @@
 
 #include "Resource/Resource.h"
 
+#include "TextureTable.h"
+
 template<typename Archive>
 void Serialize(Archive& ar, VkExtent3D& extent)
 {
@@ -42,6 +44,8 @@ namespace Engine
 
 		[[nodiscard]] Vulkan::ImageView& GetImageView() const;
 		[[nodiscard]] Vulkan::Sampler& GetSampler() const;
+		// Index of the texture in the device's texture table, only 2D textures are added to it
+		[[nodiscard]] uint32_t GetTextureIndex() const;
 
 		[[nodiscard]] VkExtent3D GetExtent() const;
 
@@ -89,6 +93,9 @@ namespace Engine
 
 		std::unique_ptr<Vulkan::ImageView> imageView;
 		std::unique_ptr<Vulkan::Sampler> sampler;
+
+		// Declared last, so the slot is cleared before the view and sampler it points to are destroyed
+		TextureSlot slot;
 	};
 
 }
@@ -0,0 +1,75 @@
+#include "TextureTable.h"
+
+#include "Vulkan/Device.h"
+#include "Vulkan/ImageView.h"
+#include "Vulkan/Sampler.h"
+
+namespace Engine
+{
+	TextureTable::TextureTable(Vulkan::Device& device) : device(device)
+	{
+		const ShaderResource textures{
+			.type = ShaderResourceType::ImageSampler,
+			.stages = ShaderStage::Vertex | ShaderStage::Fragment,
+			.set = SET,
+			.binding = BINDING,
+			.arraySize = MAX_TEXTURES,
+			.mode = ShaderResourceMode::Bindless,
+		};
+
+		descriptorSetLayout = std::make_shared<Vulkan::DescriptorSetLayout>(device, SET, std::vector{ textures });
+		descriptorPool = std::make_unique<Vulkan::DescriptorPool>(device, *descriptorSetLayout, 1);
+		descriptorSet = descriptorPool->Allocate();
+	}
+
+	TextureSlot TextureTable::Add(const Vulkan::ImageView& imageView, const Vulkan::Sampler& sampler)
+	{
+		const auto index = indices.Allocate(1);
+
+		if (!index)
+		{
+			throw std::runtime_error("texture table is full");
+		}
+
+		const VkDescriptorImageInfo info{
+			.sampler = sampler.GetHandle(),
+			.imageView = imageView.GetHandle(),
+			.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		};
+
+		const VkWriteDescriptorSet write{
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.dstSet = descriptorSet,
+			.dstBinding = BINDING,
+			.dstArrayElement = *index,
+			.descriptorCount = 1,
+			.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+			.pImageInfo = &info,
+		};
+
+		vkUpdateDescriptorSets(device.GetHandle(), 1, &write, 0, nullptr);
+
+		return { *this, *index };
+	}
+
+	const std::shared_ptr<Vulkan::DescriptorSetLayout>& TextureTable::GetDescriptorSetLayout() const
+	{
+		return descriptorSetLayout;
+	}
+
+	VkDescriptorSet TextureTable::GetDescriptorSet() const
+	{
+		return descriptorSet;
+	}
+
+	uint32_t TextureTable::GetTextureCount() const
+	{
+		return MAX_TEXTURES - indices.GetFreeSize();
+	}
+
+	// The descriptor is left in place, partially bound sets only require the slots shaders actually read to be valid
+	void TextureTable::Remove(uint32_t index)
+	{
+		indices.Free(index, 1);
+	}
+}
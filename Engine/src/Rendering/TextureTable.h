@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Vulkan/DescriptorPool.h"
+#include "Vulkan/DescriptorSetLayout.h"
+
+#include "Common/FreeListAllocator.h"
+
+#include "TableSlot.h"
+
+namespace Vulkan
+{
+	class Device;
+	class ImageView;
+	class Sampler;
+}
+
+namespace Engine
+{
+	class TextureTable;
+
+	using TextureSlot = TableSlot<TextureTable>;
+
+	// A single descriptor set holding every loaded 2D texture, which shaders index into instead of having
+	// textures bound per draw. It is bound once per pipeline layout and written as textures come and go.
+	class TextureTable
+	{
+	public:
+		static constexpr uint32_t SET = 1;
+		static constexpr uint32_t BINDING = 0;
+		static constexpr uint32_t MAX_TEXTURES = 4096;
+
+		explicit TextureTable(Vulkan::Device& device);
+
+		TextureSlot Add(const Vulkan::ImageView& imageView, const Vulkan::Sampler& sampler);
+
+		[[nodiscard]] const std::shared_ptr<Vulkan::DescriptorSetLayout>& GetDescriptorSetLayout() const;
+		[[nodiscard]] VkDescriptorSet GetDescriptorSet() const;
+
+		[[nodiscard]] uint32_t GetTextureCount() const;
+
+	private:
+		friend class TableSlot<TextureTable>;
+
+		void Remove(uint32_t index);
+
+		Vulkan::Device& device;
+
+		std::shared_ptr<Vulkan::DescriptorSetLayout> descriptorSetLayout;
+		std::unique_ptr<Vulkan::DescriptorPool> descriptorPool;
+		VkDescriptorSet descriptorSet{ VK_NULL_HANDLE };
+
+		// Indices given back by removed textures are handed out again first
+		FreeListAllocator indices{ MAX_TEXTURES };
+	};
+}
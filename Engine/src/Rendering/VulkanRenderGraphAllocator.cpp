@@ -4,22 +4,8 @@
 
 namespace Engine
 {
-    VulkanRenderGraphAllocator::VulkanRenderGraphAllocator(Vulkan::Device& device)
-        : device(device)
+    VkImageUsageFlags GetImageUsage(const RenderTextureDesc& desc)
     {
-    }
-
-    RenderTexture VulkanRenderGraphAllocator::Allocate(const RenderTextureDesc& desc)
-    {
-        auto& vector = pool[desc];
-
-        if (!vector.empty())
-        {
-            auto* attachment = vector.back();
-            vector.pop_back();
-            return { attachment };
-        }
-
         VkImageUsageFlags usage{ 0 };
 
         if (bool(desc.usage & RenderTextureUsage::Sampled))
@@ -39,51 +25,436 @@ namespace Engine
             }
         }
 
-        VkFormat format{ VK_FORMAT_UNDEFINED };
+        return usage;
+    }
 
+    VkFormat GetImageFormat(const RenderTextureDesc& desc)
+    {
         switch (desc.format)
         {
         case RenderTextureFormat::Depth:
-            format = VK_FORMAT_D16_UNORM;
-            break;
+            return VK_FORMAT_D16_UNORM;
         case RenderTextureFormat::HDR:
-            format = VK_FORMAT_R16G16B16A16_SFLOAT;
-            break;
+            return VK_FORMAT_R16G16B16A16_SFLOAT;
         case RenderTextureFormat::Linear:
-            format = VK_FORMAT_B8G8R8A8_UNORM;
-            break;
+            return VK_FORMAT_B8G8R8A8_UNORM;
         case RenderTextureFormat::sRGB:
-            format = VK_FORMAT_B8G8R8A8_SRGB;
-            break;
+            return VK_FORMAT_B8G8R8A8_SRGB;
         }
 
-        auto attachment = RenderAttachment::Builder(device)
-            .Extent({ desc.width, desc.height })
-            .Usage(usage)
-            .Format(format)
-            .Build();
+        return VK_FORMAT_UNDEFINED;
+    }
 
-        attachments.push_back(std::move(attachment));
+    VulkanRenderGraphAllocator::VulkanRenderGraphAllocator(Vulkan::Device& device, const VulkanRenderGraphAllocatorSettings& settings)
+        : settings(settings), device(device)
+    {
+    }
+
+    VulkanRenderGraphAllocator::~VulkanRenderGraphAllocator()
+    {
+        for (auto& block : blocks)
+        {
+            DestroyBlock(*block);
+        }
+    }
+
+    void VulkanRenderGraphAllocator::BeginFrame()
+    {
+        frame++;
+        frameImageBytes = 0;
 
-        return { attachments.back().get() };
+        EvictUnused();
+
+        if (settings.budget > 0)
+        {
+            EvictToBudget(settings.budget);
+        }
+    }
+
+    RenderTexture VulkanRenderGraphAllocator::Allocate(const RenderTextureDesc& desc)
+    {
+        auto& block = RequestBlock(desc);
+
+        auto& pooled = block.attachments[desc];
+        auto& attachment = pooled.attachment;
+
+        if (!attachment)
+        {
+            attachment = CreateAttachment(desc, block.allocation);
+
+            owners[attachment.get()] = &block;
+        }
+
+        pooled.lastUsed = frame;
+        block.lastUsed = frame;
+
+        frameImageBytes += requirements.at(desc).size;
+
+        // Another image used this memory since, so the contents are gone and the first barrier
+        // has to wait on whatever that image was last used for
+        if (block.last != attachment.get())
+        {
+            attachment->GetLayout() = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachment->GetScope() = block.scope;
+        }
+
+        block.occupant = attachment.get();
+
+        return { attachment.get() };
     }
 
     void VulkanRenderGraphAllocator::Free(const RenderTexture resource, const RenderTextureDesc& desc)
     {
-        assert(pool.contains(desc));
+        assert(owners.contains(resource.attachment));
+
+        auto* block = owners[resource.attachment];
 
-        auto& vector = pool[desc];
+        assert(block->occupant == resource.attachment);
 
-        vector.push_back(resource.attachment);
+        block->occupant = nullptr;
+        block->last = resource.attachment;
+        block->scope = resource.attachment->GetScope();
     }
 
     RenderBuffer VulkanRenderGraphAllocator::Allocate(const RenderBufferDesc& desc)
     {
-        return {};
+        assert(desc.size > 0);
+
+        auto& transient = RequestBuffer(desc);
+
+        transient.occupied = true;
+        transient.lastUsed = frame;
+
+        // The scope is kept from the previous occupant, so the first access waits until it is done with the buffer
+        return { BufferAllocation(*transient.buffer, desc.size, 0), &transient.scope };
     }
 
     void VulkanRenderGraphAllocator::Free(RenderBuffer resource, const RenderBufferDesc& desc)
     {
+        auto* buffer = &resource.allocation.GetBuffer();
+
+        assert(bufferOwners.contains(buffer));
+
+        auto* transient = bufferOwners[buffer];
+
+        assert(transient->occupied);
+
+        transient->occupied = false;
+    }
+
+    VulkanRenderGraphAllocatorStats VulkanRenderGraphAllocator::GetStats() const
+    {
+        VulkanRenderGraphAllocatorStats stats{ .imageBytes = frameImageBytes };
+
+        for (const auto& block : blocks)
+        {
+            if (block->lastUsed == frame)
+            {
+                stats.memoryBytes += block->size;
+            }
+
+            (block->lastUsed == frame ? stats.liveBytes : stats.pooledBytes) += block->size;
+        }
+
+        for (const auto& transient : buffers)
+        {
+            stats.bufferBytes += transient->buffer->GetSize();
+
+            (transient->lastUsed == frame ? stats.liveBytes : stats.pooledBytes) += transient->buffer->GetSize();
+        }
+
+        return stats;
+    }
+
+    const VkMemoryRequirements& VulkanRenderGraphAllocator::GetMemoryRequirements(const RenderTextureDesc& desc)
+    {
+        if (auto it = requirements.find(desc); it != requirements.end())
+        {
+            return it->second;
+        }
+
+        VkImageCreateInfo createInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = GetImageFormat(desc),
+            .extent = { desc.width, desc.height, 1 },
+            .mipLevels = 1,
+            .arrayLayers = 1,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = GetImageUsage(desc),
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        };
+
+        VkDeviceImageMemoryRequirements info{
+            .sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS,
+            .pCreateInfo = &createInfo,
+        };
+
+        VkMemoryRequirements2 memoryRequirements{ VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2 };
+
+        vkGetDeviceImageMemoryRequirements(device.GetHandle(), &info, &memoryRequirements);
+
+        return requirements[desc] = memoryRequirements.memoryRequirements;
+    }
+
+    VulkanRenderGraphAllocator::MemoryBlock& VulkanRenderGraphAllocator::RequestBlock(const RenderTextureDesc& desc)
+    {
+        const auto& memoryRequirements = GetMemoryRequirements(desc);
+
+        MemoryBlock* best{ nullptr };
+
+        // Best fit among the free blocks, preferring one that already holds an image for this descriptor
+        for (auto& block : blocks)
+        {
+            if (block->occupant || block->size < memoryRequirements.size || !(memoryRequirements.memoryTypeBits & (1u << block->memoryType)))
+            {
+                continue;
+            }
+
+            if (!best || block->size < best->size || (block->size == best->size && block->attachments.contains(desc)))
+            {
+                best = block.get();
+            }
+        }
+
+        if (best)
+        {
+            return *best;
+        }
+
+        if (settings.budget > 0)
+        {
+            EvictToBudget(settings.budget > memoryRequirements.size ? settings.budget - memoryRequirements.size : 0);
+        }
+
+        VmaAllocationCreateInfo createInfo{
+            .flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT,
+            .requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            .priority = 1.0f,
+        };
+
+        VmaAllocation allocation;
+        VmaAllocationInfo allocationInfo;
+
+        if (vmaAllocateMemory(device.GetAllocator(), &memoryRequirements, &createInfo, &allocation, &allocationInfo) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to allocate transient texture memory!");
+        }
+
+        auto block = std::make_unique<MemoryBlock>();
+        block->allocation = allocation;
+        block->size = allocationInfo.size;
+        block->memoryType = allocationInfo.memoryType;
+
+        blocks.push_back(std::move(block));
 
+        return *blocks.back();
+    }
+
+    VulkanRenderGraphAllocator::TransientBuffer& VulkanRenderGraphAllocator::RequestBuffer(const RenderBufferDesc& desc)
+    {
+        TransientBuffer* best{ nullptr };
+
+        for (auto& transient : buffers)
+        {
+            if (transient->occupied || transient->buffer->GetSize() < desc.size)
+            {
+                continue;
+            }
+
+            if (!best || transient->buffer->GetSize() < best->buffer->GetSize())
+            {
+                best = transient.get();
+            }
+        }
+
+        if (best)
+        {
+            return *best;
+        }
+
+        // Rounded up so buffers of slightly different sizes can still share
+        static constexpr uint32_t granularity = 256;
+
+        const auto size = (desc.size + granularity - 1) & ~(granularity - 1);
+
+        if (settings.budget > 0)
+        {
+            EvictToBudget(settings.budget > size ? settings.budget - size : 0);
+        }
+
+        auto transient = std::make_unique<TransientBuffer>();
+        transient->buffer = Vulkan::BufferBuilder()
+            .BufferUsage(Vulkan::BufferUsageFlags::Storage)
+            .Size(size)
+            .Build(device);
+
+        bufferOwners[transient->buffer.get()] = transient.get();
+
+        buffers.push_back(std::move(transient));
+
+        return *buffers.back();
+    }
+
+    // Images of descriptors that stopped being requested, e.g. after a resize, go first, then the blocks and buffers they leave idle
+    void VulkanRenderGraphAllocator::EvictUnused()
+    {
+        auto expired = [&](uint64_t lastUsed) {
+            return IsReleasable(lastUsed) && lastUsed + settings.maxUnusedFrames <= frame;
+        };
+
+        for (auto& block : blocks)
+        {
+            std::erase_if(block->attachments, [&](const auto& entry) {
+                const auto& [desc, pooled] = entry;
+
+                if (!expired(pooled.lastUsed))
+                {
+                    return false;
+                }
+
+                if (block->last == pooled.attachment.get())
+                {
+                    block->last = nullptr;
+                }
+
+                owners.erase(pooled.attachment.get());
+
+                return true;
+            });
+        }
+
+        std::erase_if(blocks, [&](const auto& block) {
+            if (block->occupant || !expired(block->lastUsed))
+            {
+                return false;
+            }
+
+            DestroyBlock(*block);
+
+            return true;
+        });
+
+        std::erase_if(buffers, [&](const auto& transient) {
+            if (transient->occupied || !expired(transient->lastUsed))
+            {
+                return false;
+            }
+
+            DestroyBuffer(*transient);
+
+            return true;
+        });
+
+        std::erase_if(requirements, [&](const auto& entry) {
+            return std::ranges::none_of(blocks, [&](const auto& block) {
+                return block->attachments.contains(entry.first);
+            });
+        });
+    }
+
+    void VulkanRenderGraphAllocator::EvictToBudget(VkDeviceSize budget)
+    {
+        auto held = GetHeldBytes();
+
+        while (held > budget)
+        {
+            MemoryBlock* block{ nullptr };
+            TransientBuffer* buffer{ nullptr };
+            uint64_t oldest = frame;
+
+            for (auto& candidate : blocks)
+            {
+                if (!candidate->occupant && IsReleasable(candidate->lastUsed) && candidate->lastUsed <= oldest)
+                {
+                    block = candidate.get();
+                    oldest = candidate->lastUsed;
+                }
+            }
+
+            for (auto& candidate : buffers)
+            {
+                if (!candidate->occupied && IsReleasable(candidate->lastUsed) && candidate->lastUsed <= oldest)
+                {
+                    block = nullptr;
+                    buffer = candidate.get();
+                    oldest = candidate->lastUsed;
+                }
+            }
+
+            if (block)
+            {
+                held -= block->size;
+
+                DestroyBlock(*block);
+
+                std::erase_if(blocks, [&](const auto& candidate) { return candidate.get() == block; });
+            }
+            else if (buffer)
+            {
+                held -= buffer->buffer->GetSize();
+
+                DestroyBuffer(*buffer);
+
+                std::erase_if(buffers, [&](const auto& candidate) { return candidate.get() == buffer; });
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    void VulkanRenderGraphAllocator::DestroyBlock(MemoryBlock& block)
+    {
+        for (const auto& [desc, pooled] : block.attachments)
+        {
+            owners.erase(pooled.attachment.get());
+        }
+
+        block.attachments.clear();
+
+        vmaFreeMemory(device.GetAllocator(), block.allocation);
+    }
+
+    void VulkanRenderGraphAllocator::DestroyBuffer(TransientBuffer& transient)
+    {
+        bufferOwners.erase(transient.buffer.get());
+
+        transient.buffer.reset();
+    }
+
+    // Frames are only recorded once their previous use finished on the GPU, so that is how far back memory is still in use
+    bool VulkanRenderGraphAllocator::IsReleasable(uint64_t lastUsed) const
+    {
+        return lastUsed + settings.framesInFlight <= frame;
+    }
+
+    VkDeviceSize VulkanRenderGraphAllocator::GetHeldBytes() const
+    {
+        VkDeviceSize held{ 0 };
+
+        for (const auto& block : blocks)
+        {
+            held += block->size;
+        }
+
+        for (const auto& transient : buffers)
+        {
+            held += transient->buffer->GetSize();
+        }
+
+        return held;
+    }
+
+    std::unique_ptr<RenderAttachment> VulkanRenderGraphAllocator::CreateAttachment(const RenderTextureDesc& desc, VmaAllocation memory) const
+    {
+        return RenderAttachment::Builder(device)
+            .Extent({ desc.width, desc.height })
+            .Usage(GetImageUsage(desc))
+            .Format(GetImageFormat(desc))
+            .Alias(memory)
+            .Build();
     }
-}
\ No newline at end of file
+}
@@ -11,10 +11,37 @@ namespace Engine
 {
     class RenderAttachment;
 
+    struct VulkanRenderGraphAllocatorSettings
+    {
+        // Frames the GPU may still be using memory from, nothing used more recently than this is ever released
+        uint32_t framesInFlight{ 2 };
+        // Pooled images, memory blocks and buffers left unused for this many frames are released
+        uint32_t maxUnusedFrames{ 60 };
+        // Memory the pool tries to stay under by releasing its least recently used entries first, zero for no limit.
+        // A frame needing more than this still gets it.
+        VkDeviceSize budget{ 0 };
+    };
+
+    struct VulkanRenderGraphAllocatorStats
+    {
+        // Memory the transient images of the current frame would take if each one had its own allocation
+        VkDeviceSize imageBytes{ 0 };
+        // Memory actually backing them
+        VkDeviceSize memoryBytes{ 0 };
+        // Memory held by the pooled transient buffers
+        VkDeviceSize bufferBytes{ 0 };
+        // Memory of blocks and buffers the current frame used, and of the ones sitting idle in the pool
+        VkDeviceSize liveBytes{ 0 };
+        VkDeviceSize pooledBytes{ 0 };
+
+        [[nodiscard]] VkDeviceSize GetSavedBytes() const { return imageBytes > memoryBytes ? imageBytes - memoryBytes : 0; }
+    };
+
     class VulkanRenderGraphAllocator final : public RenderGraphAllocator
     {
     public:
-        explicit VulkanRenderGraphAllocator(Vulkan::Device& device);
+        explicit VulkanRenderGraphAllocator(Vulkan::Device& device, const VulkanRenderGraphAllocatorSettings& settings = {});
+        ~VulkanRenderGraphAllocator() override;
 
         RenderTexture Allocate(const RenderTextureDesc& desc) override;
         void Free(RenderTexture resource, const RenderTextureDesc& desc) override;
@@ -22,10 +49,72 @@ namespace Engine
         RenderBuffer Allocate(const RenderBufferDesc &desc) override;
         void Free(RenderBuffer resource, const RenderBufferDesc &desc) override;
 
+        // Advances the frame used to age pooled memory and releases what went unused for too long or doesn't fit the budget.
+        // Has to be called once per frame, after the frame being recorded waited for its previous use to finish.
+        void BeginFrame();
+
+        [[nodiscard]] VulkanRenderGraphAllocatorStats GetStats() const;
+
     private:
-        std::vector<std::unique_ptr<RenderAttachment>> attachments;
-        std::unordered_map<RenderTextureDesc, std::vector<RenderAttachment*>> pool;
-        
+        struct PooledAttachment
+        {
+            std::unique_ptr<RenderAttachment> attachment;
+            uint64_t lastUsed{ 0 };
+        };
+
+        // A memory allocation shared by every transient image placed in it. Images are created lazily
+        // per descriptor and aliased, so only one of them can be live at a time.
+        struct MemoryBlock
+        {
+            VmaAllocation allocation{ VK_NULL_HANDLE };
+            VkDeviceSize size{ 0 };
+            uint32_t memoryType{ 0 };
+
+            RenderAttachment* occupant{ nullptr };
+            RenderAttachment* last{ nullptr };
+            BarrierScope scope{};
+
+            uint64_t lastUsed{ 0 };
+
+            std::unordered_map<RenderTextureDesc, PooledAttachment> attachments;
+        };
+
+        // A device local buffer handed to transient buffers whose lifetimes don't overlap
+        struct TransientBuffer
+        {
+            std::unique_ptr<Vulkan::Buffer> buffer;
+
+            bool occupied{ false };
+            BarrierScope scope{};
+
+            uint64_t lastUsed{ 0 };
+        };
+
+        const VkMemoryRequirements& GetMemoryRequirements(const RenderTextureDesc& desc);
+        MemoryBlock& RequestBlock(const RenderTextureDesc& desc);
+        std::unique_ptr<RenderAttachment> CreateAttachment(const RenderTextureDesc& desc, VmaAllocation memory) const;
+        TransientBuffer& RequestBuffer(const RenderBufferDesc& desc);
+
+        void EvictUnused();
+        void EvictToBudget(VkDeviceSize budget);
+        void DestroyBlock(MemoryBlock& block);
+        void DestroyBuffer(TransientBuffer& transient);
+        [[nodiscard]] bool IsReleasable(uint64_t lastUsed) const;
+        [[nodiscard]] VkDeviceSize GetHeldBytes() const;
+
+        std::vector<std::unique_ptr<MemoryBlock>> blocks;
+        std::unordered_map<RenderAttachment*, MemoryBlock*> owners;
+        std::unordered_map<RenderTextureDesc, VkMemoryRequirements> requirements;
+
+        std::vector<std::unique_ptr<TransientBuffer>> buffers;
+        std::unordered_map<const Vulkan::Buffer*, TransientBuffer*> bufferOwners;
+
+        VulkanRenderGraphAllocatorSettings settings;
+        uint64_t frame{ 0 };
+
+        // Summed per allocated resource, so images sharing a descriptor or a block each count
+        VkDeviceSize frameImageBytes{ 0 };
+
         Vulkan::Device& device;
     };
 }
@@ -11,6 +11,8 @@
 
 #include "../Resource/ResourceManager.h"
 
+#include "Common/ThreadPool.h"
+
 namespace Engine
 {
     VulkanRenderGraphCommand::VulkanRenderGraphCommand(
@@ -18,8 +20,10 @@ namespace Engine
         RenderBatcher& batcher,
         ShaderCache& shaderCache,
         Vulkan::CommandBuffer& commandBuffer,
-        const std::unordered_map<RenderTextureSampler, std::unique_ptr<Vulkan::Sampler>>& samplers
-    ) : renderContext(renderContext), batcher(batcher), shaderCache(shaderCache), commandBuffer(commandBuffer), samplers(samplers) { }
+        const std::unordered_map<RenderTextureSampler, std::unique_ptr<Vulkan::Sampler>>& samplers,
+        const BufferAllocation& instances,
+        const BufferAllocation& drawCommands
+    ) : renderContext(renderContext), batcher(batcher), shaderCache(shaderCache), commandBuffer(&commandBuffer), samplers(samplers), instances(instances), drawCommands(drawCommands) { }
 
     void VulkanRenderGraphCommand::BeforeRead(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info)
     {
@@ -28,59 +32,60 @@ namespace Engine
         auto* attachment = texture.attachment;
         auto& view = attachment->GetView();
 
-        auto& scope = attachment->GetScope();
-        auto& layout = attachment->GetLayout();
-
-        Vulkan::ImageMemoryBarrierInfo barrier
-        {
-            .srcStageMask = scope.stage,
-            .dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-            .srcAccessMask = scope.access,
-            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
-            .oldLayout = layout,
-            .newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-        };
+        AddImageBarrier(*attachment, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-        scope.stage = barrier.dstStageMask;
-        scope.access = barrier.dstAccessMask;
-        layout = barrier.newLayout;
+        AddBinding(view, *samplers.at(info.binding.sampler), info.binding.set, info.binding.location);
+    }
 
-        commandBuffer.ImageMemoryBarrier(view, barrier);
+    VkAttachmentLoadOp GetAttachmentLoadOp(RenderGraphLoadOp op)
+    {
+        switch (op)
+        {
+        case RenderGraphLoadOp::Load:
+            return VK_ATTACHMENT_LOAD_OP_LOAD;
+        case RenderGraphLoadOp::DontCare:
+            return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        default:
+            return VK_ATTACHMENT_LOAD_OP_CLEAR;
+        }
+    }
 
-        commandBuffer.BindImage(view, *samplers.at(info.binding.sampler), info.binding.set, info.binding.location, 0);
+    VkAttachmentStoreOp GetAttachmentStoreOp(RenderGraphStoreOp op)
+    {
+        switch (op)
+        {
+        case RenderGraphStoreOp::DontCare:
+            return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        default:
+            return VK_ATTACHMENT_STORE_OP_STORE;
+        }
     }
 
-    void VulkanRenderGraphCommand::BeforeWrite(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info)
+    void VulkanRenderGraphCommand::BeforeWrite(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info, const RenderGraphWriteOps& ops)
     {
         assert(info.type == RenderTextureAccessType::Attachment);
 
         auto* attachment = texture.attachment;
         auto& view = attachment->GetView();
 
-        auto& scope = attachment->GetScope();
-        auto& layout = attachment->GetLayout();
-
-        Vulkan::ImageMemoryBarrierInfo barrier
+        // Previous contents are not loaded, so the layout transition does not have to preserve them
+        if (ops.load != RenderGraphLoadOp::Load)
         {
-            .srcStageMask = scope.stage,
-            .srcAccessMask = scope.access,
-            .oldLayout = layout,
-        };
+            attachment->GetLayout() = VK_IMAGE_LAYOUT_UNDEFINED;
+        }
 
         assert(info.attachment.aspect != RenderTextureAspect::None);
 
         if (info.attachment.aspect == RenderTextureAspect::Color)
         {
-            barrier.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            AddImageBarrier(*attachment, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 
             colors.push_back({
                 .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
                 .imageView = view.GetHandle(),
-                .imageLayout = barrier.newLayout,
-                .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-                .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+                .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .loadOp = GetAttachmentLoadOp(ops.load),
+                .storeOp = GetAttachmentStoreOp(ops.store),
                 .clearValue = {.color = {0.2f, 0.2f, 0.2f, 1.f}},
             });
 
@@ -88,52 +93,187 @@ namespace Engine
         }
         else
         {
-            barrier.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            AddImageBarrier(
+                *attachment,
+                VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+            );
 
             depth = std::make_unique<VkRenderingAttachmentInfo>(VkRenderingAttachmentInfo{
                 .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
                 .imageView = view.GetHandle(),
-                .imageLayout = barrier.newLayout,
-                .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-                .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+                .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                .loadOp = GetAttachmentLoadOp(ops.load),
+                .storeOp = GetAttachmentStoreOp(ops.store),
                 .clearValue = {.depthStencil = {.depth = 0.f, .stencil = 0}},
             });
 
             depthFormat = attachment->GetFormat();
         }
 
-        scope.stage = barrier.dstStageMask;
-        scope.access = barrier.dstAccessMask;
-        layout = barrier.newLayout;
+        extent = attachment->GetExtent();
+    }
+
+    VkPipelineStageFlags2 GetPipelineStage(RenderGraphPipelineStage stages)
+    {
+        VkPipelineStageFlags2 stage{ VK_PIPELINE_STAGE_2_NONE };
+
+        if (bool(stages & RenderGraphPipelineStage::VertexShader))
+        {
+            stage |= VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+        }
+
+        if (bool(stages & RenderGraphPipelineStage::FragmentShader))
+        {
+            stage |= VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+        }
 
-        commandBuffer.ImageMemoryBarrier(view, barrier);
+        if (bool(stages & RenderGraphPipelineStage::ComputeShader))
+        {
+            stage |= VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        }
 
-        extent = attachment->GetExtent();
+        if (bool(stages & RenderGraphPipelineStage::DrawIndirect))
+        {
+            stage |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+        }
+
+        return stage;
+    }
+
+    bool IsShaderAccess(RenderGraphPipelineStage stages)
+    {
+        return bool(stages & (RenderGraphPipelineStage::VertexShader | RenderGraphPipelineStage::FragmentShader | RenderGraphPipelineStage::ComputeShader));
     }
 
     void VulkanRenderGraphCommand::BeforeRead(const RenderBuffer &buffer, const RenderBufferDesc &desc, const RenderBufferAccessInfo &info)
     {
-        commandBuffer.BindBuffer(
-            buffer.allocation.GetBuffer(),
-            buffer.allocation.GetOffset(),
-            buffer.allocation.GetSize(),
-            info.set,
-            info.binding,
-            0
-        );
+        if (buffer.scope)
+        {
+            VkAccessFlags2 access{ VK_ACCESS_2_NONE };
+
+            if (IsShaderAccess(info.stages))
+            {
+                access |= VK_ACCESS_2_UNIFORM_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+            }
+
+            if (bool(info.stages & RenderGraphPipelineStage::DrawIndirect))
+            {
+                access |= VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+            }
+
+            AddBufferBarrier(buffer, GetPipelineStage(info.stages), access);
+        }
+
+        // Indirect arguments are consumed by the draw itself, there is nothing to bind
+        if (!IsShaderAccess(info.stages))
+        {
+            return;
+        }
+
+        AddBinding(buffer.allocation, info.set, info.binding);
     }
 
-    void VulkanRenderGraphCommand::BeforeWrite(const RenderBuffer &buffer, const RenderBufferDesc &desc, const RenderBufferAccessInfo &info)
+    void VulkanRenderGraphCommand::BeforeWrite(const RenderBuffer &buffer, const RenderBufferDesc &desc, const RenderBufferAccessInfo &info, const RenderGraphWriteOps& ops)
     {
+        assert(buffer.scope && IsShaderAccess(info.stages));
+
+        // Buffers have no load op, a pass that doesn't load the previous contents is expected to overwrite what it uses
+        VkAccessFlags2 access = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+
+        if (ops.load == RenderGraphLoadOp::Load)
+        {
+            access |= VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+        }
+
+        AddBufferBarrier(buffer, GetPipelineStage(info.stages), access);
 
+        AddBinding(buffer.allocation, info.set, info.binding);
     }
 
     void VulkanRenderGraphCommand::BeginPass()
     {
-        commandBuffer.BeginRendering({
+        if (secondary)
+        {
+            thread = ThreadPool::GetThreadIndex();
+
+            commandBuffer = &renderContext.GetCurrentFrame().RequestCommandBuffer(Vulkan::CommandBuffer::Level::Secondary, thread);
+            commandBuffer->Begin({
+                .colorAttachmentFormats = colorFormats,
+                .depthAttachmentFormat = depthFormat
+            });
+        }
+        else
+        {
+            commandBuffer->PipelineBarrier(imageBarriers, bufferBarriers);
+
+            imageBarriers.clear();
+            bufferBarriers.clear();
+
+            commandBuffer->BeginRendering(GetRenderingInfo(0));
+        }
+
+        // Bindings don't carry over into a secondary command buffer, so every pass starts without any
+        geometryBinding = {};
+
+        SetupRenderingState();
+    }
+
+    void VulkanRenderGraphCommand::EndPass()
+    {
+        // The rendering scope of a pass command is opened and closed by SubmitPassCommands, which still needs the attachments
+        if (secondary)
+        {
+            commandBuffer->End();
+            return;
+        }
+
+        commandBuffer->EndRendering();
+
+        colors.clear();
+        colorFormats.clear();
+
+        depth = nullptr;
+        depthFormat = VK_FORMAT_UNDEFINED;
+    }
+
+    VulkanRenderGraphCommand& VulkanRenderGraphCommand::CreatePassCommand()
+    {
+        auto& passCommand = passCommands.emplace_back(
+            std::make_unique<VulkanRenderGraphCommand>(renderContext, batcher, shaderCache, *commandBuffer, samplers, instances, drawCommands)
+        );
+
+        passCommand->commandBuffer = nullptr;
+        passCommand->secondary = true;
+
+        return *passCommand;
+    }
+
+    void VulkanRenderGraphCommand::SubmitPassCommands()
+    {
+        for (auto& passCommand : passCommands)
+        {
+            commandBuffer->PipelineBarrier(passCommand->imageBarriers, passCommand->bufferBarriers);
+
+            commandBuffer->BeginRendering(passCommand->GetRenderingInfo(VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT));
+            commandBuffer->ExecuteCommands(*passCommand->commandBuffer);
+            commandBuffer->EndRendering();
+        }
+
+        passCommands.clear();
+    }
+
+    uint32_t VulkanRenderGraphCommand::GetPendingBarrierCount() const
+    {
+        return static_cast<uint32_t>(imageBarriers.size() + bufferBarriers.size());
+    }
+
+    VkRenderingInfo VulkanRenderGraphCommand::GetRenderingInfo(VkRenderingFlags flags) const
+    {
+        return {
             .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+            .flags = flags,
             .renderArea = {
                 .offset = { 0, 0 },
                 .extent = extent,
@@ -142,44 +282,101 @@ namespace Engine
             .colorAttachmentCount = static_cast<uint32_t>(colors.size()),
             .pColorAttachments = colors.data(),
             .pDepthAttachment = depth.get(),
-        });
+        };
+    }
+
+    void VulkanRenderGraphCommand::SetupRenderingState()
+    {
+        for (const auto& binding : imageBindings)
+        {
+            commandBuffer->BindImage(*binding.view, *binding.sampler, binding.set, binding.binding, 0);
+        }
+
+        for (const auto& binding : bufferBindings)
+        {
+            commandBuffer->BindBuffer(*binding.buffer, binding.offset, binding.size, binding.set, binding.binding, 0);
+        }
+
+        imageBindings.clear();
+        bufferBindings.clear();
 
-        commandBuffer.SetPipelineRenderingState({
+        commandBuffer->SetPipelineRenderingState({
             .colorAttachmentFormats = colorFormats,
             .depthAttachmentFormat = depthFormat
         });
 
-        commandBuffer.SetViewport({{
+        commandBuffer->SetViewport({{
             .width = static_cast<float>(extent.width),
             .height = static_cast<float>(extent.height),
             .minDepth = 0.0f,
             .maxDepth = 1.0f,
         }});
 
-        commandBuffer.SetScissor({{
+        commandBuffer->SetScissor({{
             .extent = extent
         }});
     }
 
-    void VulkanRenderGraphCommand::EndPass()
+    void VulkanRenderGraphCommand::AddBinding(const Vulkan::ImageView& view, const Vulkan::Sampler& sampler, uint32_t set, uint32_t binding)
     {
-        commandBuffer.EndRendering();
+        imageBindings.push_back({ &view, &sampler, set, binding });
+    }
 
-        colors.clear();
-        colorFormats.clear();
+    void VulkanRenderGraphCommand::AddBinding(const BufferAllocation& allocation, uint32_t set, uint32_t binding)
+    {
+        bufferBindings.push_back({ &allocation.GetBuffer(), allocation.GetOffset(), allocation.GetSize(), set, binding });
+    }
 
-        depth = nullptr;
-        depthFormat = VK_FORMAT_UNDEFINED;
+    static constexpr VkAccessFlags2 writeAccess = VK_ACCESS_2_SHADER_WRITE_BIT
+        | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+        | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT
+        | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+        | VK_ACCESS_2_TRANSFER_WRITE_BIT
+        | VK_ACCESS_2_HOST_WRITE_BIT
+        | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+    void VulkanRenderGraphCommand::AddImageBarrier(RenderAttachment& attachment, VkPipelineStageFlags2 stage, VkAccessFlags2 access, VkImageLayout layout)
+    {
+        auto& scope = attachment.GetScope();
+        auto& current = attachment.GetLayout();
+
+        // Reads after reads in the same layout need no barrier, the scope just grows so the next write waits on all of them
+        if (current == layout && !(scope.access & writeAccess) && !(access & writeAccess))
+        {
+            scope.stage |= stage;
+            scope.access |= access;
+            return;
+        }
+
+        auto& view = attachment.GetView();
+
+        imageBarriers.push_back({
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+            .srcStageMask = scope.stage,
+            .srcAccessMask = scope.access,
+            .dstStageMask = stage,
+            .dstAccessMask = access,
+            .oldLayout = current,
+            .newLayout = layout,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = view.GetImage().GetHandle(),
+            .subresourceRange = view.GetSubresourceRange(),
+        });
+
+        scope.stage = stage;
+        scope.access = access;
+        current = layout;
     }
 
     void VulkanRenderGraphCommand::BindUniformBuffer(void* data, uint32_t size, uint32_t set, uint32_t binding)
     {
         auto& frame = renderContext.GetCurrentFrame();
 
-        auto allocation = frame.RequestBufferAllocation(Vulkan::BufferUsageFlags::Uniform, size);
+        auto allocation = frame.RequestBufferAllocation(Vulkan::BufferUsageFlags::Uniform, size, thread);
         allocation.SetData(data);
 
-        commandBuffer.BindBuffer(allocation.GetBuffer(), allocation.GetOffset(), allocation.GetSize(), set, binding, 0);
+        commandBuffer->BindBuffer(allocation.GetBuffer(), allocation.GetOffset(), allocation.GetSize(), set, binding, 0);
     }
 
     void VulkanRenderGraphCommand::DrawGeometry(DrawGeometrySettings settings)
@@ -207,7 +404,11 @@ namespace Engine
         vertexInputState.bindings[0].stride = sizeof(Vertex);
         vertexInputState.bindings[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-        commandBuffer.SetVertexInputState(vertexInputState);
+        AddInstanceInput(vertexInputState);
+
+        commandBuffer->SetVertexInputState(vertexInputState);
+
+        BindInstances();
 
         switch(settings.type) {
         case RenderGeometryType::Opaque:
@@ -226,27 +427,26 @@ namespace Engine
         float normalBias;
     };
 
-    struct ModelUniform
+    struct ShadowUniform
     {
-        glm::mat4 localToWorldMatrix;
         glm::mat4 viewProjection;
     };
 
-    struct PbrPushConstant
+    struct MaterialPushConstant
     {
-        glm::vec4 albedoColor;
-        float metallicFactor;
-        float roughnessFactor;
-        float alphaCutoff;
+        uint32_t material;
     };
 
     void VulkanRenderGraphCommand::DrawShadow(DrawShadowSettings settings)
     {
+        // A copy of the cached shadow map may have been blitted before in the same pass
+        commandBuffer->SetRasterizationState({});
+
         auto shaders = shaderCache.Get("shadowmap", {}, ShaderStage::Vertex);
 
         auto& layout = renderContext.GetDevice().GetResourceCache().RequestPipelineLayout({ std::get<0>(shaders) });
 
-        commandBuffer.BindPipelineLayout(layout);
+        commandBuffer->BindPipelineLayout(layout);
 
         Vulkan::VertexInputState vertexInputState{};
 
@@ -266,49 +466,41 @@ namespace Engine
         vertexInputState.bindings[0].stride = sizeof(Vertex);
         vertexInputState.bindings[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-        commandBuffer.SetVertexInputState(vertexInputState);
+        AddInstanceInput(vertexInputState);
 
-        auto view = glm::lookAt(-settings.lightDirection, glm::vec3{ 0 }, glm::vec3{ 0, 1, 0 });
+        commandBuffer->SetVertexInputState(vertexInputState);
 
-        Camera camera;
-        camera.SetOrthographic(50, -25.f, 25.f);
+        BindInstances();
 
-        auto projection = camera.GetProjection();
+        auto camera = GetShadowCamera();
 
         LightPushConstant pushConstant
         {
             .direction = settings.lightDirection,
-            .depthBias = settings.depthBias * camera.GetSize() / 2048.f,
-            .normalBias = settings.normalBias * camera.GetSize() / 2048.f,
+            .depthBias = settings.depthBias * camera.GetSize() / shadowMapResolution,
+            .normalBias = settings.normalBias * camera.GetSize() / shadowMapResolution,
         };
 
-        commandBuffer.PushConstants(VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(LightPushConstant), &pushConstant);
+        commandBuffer->PushConstants(VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(LightPushConstant), &pushConstant);
 
-        for (const auto& opaque : batcher.GetOpaques())
-        {
-            ModelUniform uniform{
-                .localToWorldMatrix = opaque.transform,
-                .viewProjection = projection * view,
-            };
+        ShadowUniform uniform{
+            .viewProjection = GetShadowViewProjection(settings.lightDirection),
+        };
 
-            BindUniformBuffer(&uniform, sizeof(ModelUniform), 0, 0);
+        BindUniformBuffer(&uniform, sizeof(ShadowUniform), 0, 0);
 
-            opaque.primitive->Draw(commandBuffer);
+        if (settings.casters == ShadowCasters::Static)
+        {
+            DrawBatches(batcher.GetStaticShadowCasterBatches(), batcher.GetStaticShadowCasterDraws(), {});
+            return;
         }
+
+        DrawBatches(batcher.GetShadowCasterBatches(), batcher.GetShadowCasterDraws(), {});
     }
 
     void VulkanRenderGraphCommand::DrawOpaques(std::string_view shader)
     {
-        for (const auto& opaque : batcher.GetOpaques())
-        {
-            const auto material = opaque.primitive->GetMaterial();
-
-            SetupShader(shader, *material);
-
-            UpdateModelUniform(commandBuffer, opaque.transform, *material);
-
-            opaque.primitive->Draw(commandBuffer);
-        }
+        DrawBatches(batcher.GetOpaqueBatches(), batcher.GetOpaqueDraws(), shader);
     }
 
     void VulkanRenderGraphCommand::DrawTransparents(std::string_view shader)
@@ -318,41 +510,74 @@ namespace Engine
             .blendEnable = VK_TRUE,
         });
 
-        commandBuffer.SetColorBlendState(colorBlendState);
+        commandBuffer->SetColorBlendState(colorBlendState);
+
+        DrawBatches(batcher.GetTransparentBatches(), batcher.GetTransparentDraws(), shader);
+    }
 
-        for (const auto& transparent : batcher.GetTransparents())
+    // Without a shader the bound pipeline layout is kept and materials are ignored, like for the shadow map
+    void VulkanRenderGraphCommand::DrawBatches(const std::vector<RenderBatch>& batches, const std::vector<RenderDraw>& draws, std::string_view shader)
+    {
+        for (const auto& draw : draws)
         {
-            const auto material = transparent.primitive->GetMaterial();
+            const auto& primitive = *draw.primitive;
 
-            SetupShader(shader, *material);
+            if (!shader.empty())
+            {
+                const auto material = primitive.GetMaterial();
 
-            UpdateModelUniform(commandBuffer, transparent.transform, *material);
+                SetupShader(shader, *material);
+            }
 
-            transparent.primitive->Draw(commandBuffer);
-        }
-    }
+            if (draw.indirect)
+            {
+                primitive.BindGeometry(*commandBuffer, geometryBinding);
 
-    void VulkanRenderGraphCommand::UpdateModelUniform(Vulkan::CommandBuffer& commandBuffer, const glm::mat4& matrix, const Material& material)
-    {
-        ModelUniform uniform{};
-        uniform.localToWorldMatrix = matrix;
+                const auto offset = drawCommands.GetOffset() + draw.firstCommand * static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
 
-        BindUniformBuffer(&uniform, sizeof(ModelUniform), 0, 1);
+                commandBuffer->DrawIndexedIndirect(drawCommands.GetBuffer(), offset, draw.batchCount);
+                continue;
+            }
 
-        if (const auto albedo = material.GetAlbedoTexture())
-        {
-            commandBuffer.BindImage(albedo->GetImageView(), albedo->GetSampler(), 0, 2, 0);
+            for (uint32_t index = draw.firstBatch; index < draw.firstBatch + draw.batchCount; index++)
+            {
+                const auto& batch = batches[index];
+
+                primitive.Draw(*commandBuffer, geometryBinding, batch.instanceCount, batch.firstInstance);
+            }
         }
+    }
 
-        if (const auto normal = material.GetNormalTexture())
+    // Instance transforms are read as four vec4 attributes from binding 1, after the per vertex ones
+    void VulkanRenderGraphCommand::AddInstanceInput(Vulkan::VertexInputState& vertexInputState)
+    {
+        for (uint32_t column = 0; column < 4; column++)
         {
-            commandBuffer.BindImage(normal->GetImageView(), normal->GetSampler(), 0, 3, 0);
+            vertexInputState.attributes.push_back({
+                .location = 3 + column,
+                .binding = 1,
+                .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+                .offset = column * static_cast<uint32_t>(sizeof(glm::vec4)),
+            });
         }
 
-        if (const auto metallicRoughness = material.GetMetallicRoughnessTexture())
+        vertexInputState.bindings.push_back({
+            .binding = 1,
+            .stride = sizeof(glm::mat4),
+            .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE,
+        });
+    }
+
+    void VulkanRenderGraphCommand::BindInstances()
+    {
+        if (instances.GetSize() == 0)
         {
-            commandBuffer.BindImage(metallicRoughness->GetImageView(), metallicRoughness->GetSampler(), 0, 4, 0);
+            return;
         }
+
+        const VkDeviceSize offset = instances.GetOffset();
+
+        vkCmdBindVertexBuffers(commandBuffer->GetHandle(), 1, 1, &instances.GetBuffer().GetHandle(), &offset);
     }
 
     void VulkanRenderGraphCommand::SetupShader(std::string_view name, const Material& material)
@@ -363,32 +588,62 @@ namespace Engine
 
         auto& layout = renderContext.GetDevice().GetResourceCache().RequestPipelineLayout({std::get<0>(shaders), std::get<1>(shaders)});
 
-        commandBuffer.BindPipelineLayout(layout);
+        commandBuffer->BindPipelineLayout(layout);
 
         if (layout.HasShaderResource(ShaderResourceType::PushConstant))
         {
-            PbrPushConstant pushConstant
+            // Material parameters live in the material table, draws only tell the shader which one to read
+            auto& materialTable = renderContext.GetDevice().GetMaterialTable();
+
+            commandBuffer->BindBuffer(materialTable.GetBuffer(), 0, materialTable.GetSize(), 0, 2, 0);
+
+            MaterialPushConstant pushConstant
             {
-                .albedoColor = material.GetAlbedoColor(),
-                .metallicFactor = material.GetMetallicFactor(),
-                .roughnessFactor = material.GetRoughnessFactor(),
-                .alphaCutoff = material.GetAlphaCutoff(),
+                .material = material.GetMaterialIndex(),
             };
 
-            commandBuffer.PushConstants(VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PbrPushConstant), &pushConstant);
+            commandBuffer->PushConstants(VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(MaterialPushConstant), &pushConstant);
         }
     }
 
     void VulkanRenderGraphCommand::Blit(std::string_view shader)
     {
-        commandBuffer.SetRasterizationState({ VK_CULL_MODE_FRONT_BIT });
+        commandBuffer->SetRasterizationState({ VK_CULL_MODE_FRONT_BIT });
 
         auto shaders = shaderCache.Get(shader, {}, ShaderStage::Vertex, ShaderStage::Fragment);
 
         auto& layout = renderContext.GetDevice().GetResourceCache().RequestPipelineLayout({ std::get<0>(shaders), std::get<1>(shaders) });
 
-        commandBuffer.BindPipelineLayout(layout);
+        commandBuffer->BindPipelineLayout(layout);
+
+        commandBuffer->Draw(3, 1, 0, 0);
+    }
+
+    void VulkanRenderGraphCommand::AddBufferBarrier(const RenderBuffer& buffer, VkPipelineStageFlags2 stage, VkAccessFlags2 access)
+    {
+        auto& scope = *buffer.scope;
+
+        if (!(scope.access & writeAccess) && !(access & writeAccess))
+        {
+            scope.stage |= stage;
+            scope.access |= access;
+            return;
+        }
+
+        bufferBarriers.push_back({
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+            .srcStageMask = scope.stage,
+            .srcAccessMask = scope.access,
+            .dstStageMask = stage,
+            .dstAccessMask = access,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = buffer.allocation.GetBuffer().GetHandle(),
+            .offset = buffer.allocation.GetOffset(),
+            .size = buffer.allocation.GetSize(),
+        });
 
-        commandBuffer.Draw(3, 1, 0, 0);
+        scope.stage = stage;
+        scope.access = access;
     }
-}
\ No newline at end of file
+}
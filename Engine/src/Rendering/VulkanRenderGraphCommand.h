@@ -2,10 +2,14 @@
 
 #include "RenderGraphCommand.h"
 #include "Rendering/RenderBatcher.h"
+#include "Rendering/GeometryBuffer.h"
 
 namespace Vulkan
 {
+    struct VertexInputState;
+    class Buffer;
     class CommandBuffer;
+    class ImageView;
     class Sampler;
 }
 
@@ -24,18 +28,28 @@ namespace Engine
             RenderBatcher& batcher,
             ShaderCache& shaderCache,
             Vulkan::CommandBuffer& commandBuffer,
-            const std::unordered_map<RenderTextureSampler, std::unique_ptr<Vulkan::Sampler>>& samplers
+            const std::unordered_map<RenderTextureSampler, std::unique_ptr<Vulkan::Sampler>>& samplers,
+            const BufferAllocation& instances,
+            const BufferAllocation& drawCommands
         );
 
         void BeforeRead(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info) override;
-        void BeforeWrite(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info) override;
+        void BeforeWrite(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info, const RenderGraphWriteOps& ops) override;
 
         void BeforeRead(const RenderBuffer &buffer, const RenderBufferDesc &desc, const RenderBufferAccessInfo &info) override;
-        void BeforeWrite(const RenderBuffer &buffer, const RenderBufferDesc &desc, const RenderBufferAccessInfo &info) override;
+        void BeforeWrite(const RenderBuffer &buffer, const RenderBufferDesc &desc, const RenderBufferAccessInfo &info, const RenderGraphWriteOps& ops) override;
 
         void BeginPass() override;
         void EndPass() override;
 
+        // A command recording one pass into a secondary command buffer on whichever thread calls BeginPass
+        VulkanRenderGraphCommand& CreatePassCommand();
+        // Executes the recorded pass commands in creation order, with their barriers and rendering scopes, on this command's buffer
+        void SubmitPassCommands();
+
+        // Barriers recorded since the last pass began, emitted when the next one does
+        [[nodiscard]] uint32_t GetPendingBarrierCount() const;
+
         void BindUniformBuffer(void* data, uint32_t size, uint32_t set, uint32_t binding) override;
 
         void DrawGeometry(DrawGeometrySettings settings) override;
@@ -45,22 +59,57 @@ namespace Engine
     private:
         void DrawOpaques(std::string_view shader);
         void DrawTransparents(std::string_view shader);
+        void DrawBatches(const std::vector<RenderBatch>& batches, const std::vector<RenderDraw>& draws, std::string_view shader);
 
-        void UpdateModelUniform(Vulkan::CommandBuffer& commandBuffer, const glm::mat4& matrix, const Material& material);
+
+        static void AddInstanceInput(Vulkan::VertexInputState& vertexInputState);
+        void BindInstances();
 
         void SetupShader(std::string_view shader, const Material& material);
 
-    public:
+        void AddImageBarrier(RenderAttachment& attachment, VkPipelineStageFlags2 stage, VkAccessFlags2 access, VkImageLayout layout);
+        void AddBufferBarrier(const RenderBuffer& buffer, VkPipelineStageFlags2 stage, VkAccessFlags2 access);
+
+        void AddBinding(const Vulkan::ImageView& view, const Vulkan::Sampler& sampler, uint32_t set, uint32_t binding);
+        void AddBinding(const BufferAllocation& allocation, uint32_t set, uint32_t binding);
+
+        [[nodiscard]] VkRenderingInfo GetRenderingInfo(VkRenderingFlags flags) const;
+        void SetupRenderingState();
+
+        struct ImageBinding
+        {
+            const Vulkan::ImageView* view;
+            const Vulkan::Sampler* sampler;
+            uint32_t set;
+            uint32_t binding;
+        };
 
+        struct BufferBinding
+        {
+            const Vulkan::Buffer* buffer;
+            uint32_t offset;
+            uint32_t size;
+            uint32_t set;
+            uint32_t binding;
+        };
 
     private:
         RenderContext& renderContext;
         RenderBatcher& batcher;
         ShaderCache& shaderCache;
-        Vulkan::CommandBuffer& commandBuffer;
+        Vulkan::CommandBuffer* commandBuffer;
+
+        // Pass commands record into a secondary buffer from the pools of the thread given by this index
+        bool secondary{ false };
+        uint32_t thread{ 0 };
 
         const std::unordered_map<RenderTextureSampler, std::unique_ptr<Vulkan::Sampler>>& samplers;
 
+        // Per frame copy of the batcher's instance transforms
+        BufferAllocation instances;
+        // Per frame copy of the batcher's indirect draw commands
+        BufferAllocation drawCommands;
+
         std::vector<VkRenderingAttachmentInfo> colors;
         std::vector<VkFormat> colorFormats;
 
@@ -68,6 +117,18 @@ namespace Engine
         VkFormat depthFormat{ VK_FORMAT_UNDEFINED };
 
         VkExtent2D extent{};
+
+        std::vector<VkImageMemoryBarrier2> imageBarriers;
+        std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+
+        // Applied when the pass begins, pass commands get their command buffer only then
+        std::vector<ImageBinding> imageBindings;
+        std::vector<BufferBinding> bufferBindings;
+
+        // Geometry buffer arena bound by the last draw of the pass
+        GeometryBinding geometryBinding{};
+
+        std::vector<std::unique_ptr<VulkanRenderGraphCommand>> passCommands;
     };
 
 }
\ No newline at end of file
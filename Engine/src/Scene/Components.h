@@ -56,6 +56,7 @@ namespace Engine::Component
 	struct MeshRender
 	{
 		std::shared_ptr<Mesh> mesh{ nullptr };
+		bool castShadows{ true };
 	};
 
 	struct Camera
@@ -170,6 +171,14 @@ namespace Engine::Component
 
 	template <class Archive>
 	void Serialize(Archive& ar, MeshRender& meshRender)
+	{
+		ar(meshRender.mesh);
+		ar(meshRender.castShadows);
+	}
+
+	// Layout of scenes saved before their format was versioned, castShadows keeps its default
+	template <class Archive>
+	void LoadUnversioned(Archive& ar, MeshRender& meshRender)
 	{
 		ar(meshRender.mesh);
 	}
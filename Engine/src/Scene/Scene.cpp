@@ -8,6 +8,32 @@ namespace Engine
         registry.on_construct<Component::Transform>().connect<&entt::registry::emplace_or_replace<Component::LocalToWorld>>(&registry);
     }
 
+    Scene::Scene(const Scene& other) : Scene()
+    {
+        *this = other;
+    }
+
+    Scene::~Scene()
+    {
+        Teardown();
+    }
+
+    uint64_t Scene::GetGeneration() const
+    {
+        return generation;
+    }
+
+    // Listeners may disconnect themselves while called, so they are taken out before
+    void Scene::Teardown()
+    {
+        const auto listeners = std::exchange(teardownListeners, {});
+
+        for (const auto& listener : listeners)
+        {
+            listener();
+        }
+    }
+
     void CopyEntities(entt::registry& destination, const entt::registry& source)
     {
         const auto entities = source.storage<entt::entity>();
@@ -45,6 +71,10 @@ namespace Engine
     {
         Resource::operator=(other);
 
+        Teardown();
+
+        generation = nextGeneration++;
+
         registry.clear();
 
         CopyEntities(registry, other.registry);
@@ -275,7 +305,11 @@ namespace Engine
         auto& transform = GetComponent<Component::Transform>(entity);
         auto& localToWorld = GetComponent<Component::LocalToWorld>(entity);
 
-        localToWorld.value = parent.value * transform.GetLocalMatrix();
+        // Only actual changes are patched, so listeners of LocalToWorld updates never hear about static entities
+        if (const auto value = parent.value * transform.GetLocalMatrix(); value != localToWorld.value)
+        {
+            registry.patch<Component::LocalToWorld>(entity, [&](auto& component) { component.value = value; });
+        }
 
         if (! HasComponent<Component::Children>(entity))
         {
@@ -4,6 +4,7 @@
 
 #include "Entity.h"
 #include "Components.h"
+#include "SceneArchive.h"
 
 #include "Resource/Resource.h"
 
@@ -68,6 +69,8 @@ namespace Engine
 	{
 	public:
 		Scene();
+		Scene(const Scene& other);
+		~Scene() override;
 		Scene& operator=(const Scene& other);
 
 		Entity::Id CreateEntity();
@@ -134,6 +137,13 @@ namespace Engine
 			return registry.any_of<T>(id);
 		}
 
+		// Signals an update of a component that was modified in place
+		template<typename T>
+		void PatchComponent(Entity::Id id)
+		{
+			registry.patch<T>(id);
+		}
+
 		template<typename... T>
 		void RemoveComponent(Entity::Id id)
 		{
@@ -152,9 +162,49 @@ namespace Engine
 			registry.on_construct<T>().template connect<MemberFunc>(instance);
 		}
 
+		template<typename T, auto MemberFunc, typename Type>
+		void OnComponentUpdated(Type instance)
+		{
+			registry.on_update<T>().template connect<MemberFunc>(instance);
+		}
+
+		template<typename T, auto MemberFunc, typename Type>
+		void OnComponentRemoved(Type instance)
+		{
+			registry.on_destroy<T>().template connect<MemberFunc>(instance);
+		}
+
+		// Called before the entities go away, when the scene is destroyed or another scene is assigned to it.
+		// Listeners are dropped once called, they have to connect again to the scene's new contents.
+		template<auto MemberFunc, typename Type>
+		void OnTeardown(Type instance)
+		{
+			teardownListeners.emplace_back(entt::connect_arg<MemberFunc>, instance);
+		}
+
+		template<typename Type>
+		void DisconnectTeardown(Type instance)
+		{
+			std::erase_if(teardownListeners, [instance](const auto& listener) { return listener.data() == instance; });
+		}
+
+		// Changes whenever the scene's contents are replaced, unlike its address which assignment keeps
+		[[nodiscard]] uint64_t GetGeneration() const;
+
+		// Drops every listener instance connected for T
+		template<typename T, typename Type>
+		void DisconnectComponentEvents(Type instance)
+		{
+			registry.on_construct<T>().disconnect(instance);
+			registry.on_update<T>().disconnect(instance);
+			registry.on_destroy<T>().disconnect(instance);
+		}
+
 		template<class Archive>
 		void Save(Archive& ar) const
 		{
+			ar(SCENE_FORMAT_TAG, SCENE_FORMAT_VERSION);
+
 			entt::snapshot snapshot{ registry };
 
 			snapshot
@@ -176,22 +226,43 @@ namespace Engine
 		template<class Archive>
 		void Load(Archive& ar)
 		{
+			uint32_t tag{ 0 };
+			ar(tag);
+
+			uint32_t version{ 0 };
+			std::optional<uint32_t> entityCount;
+
+			if (tag == SCENE_FORMAT_TAG)
+			{
+				ar(version);
+			}
+			else
+			{
+				entityCount = tag;
+			}
+
+			if (version > SCENE_FORMAT_VERSION)
+			{
+				throw std::runtime_error("scene was saved in a newer format");
+			}
+
+			SceneInputArchive<Archive> input{ ar, version, entityCount };
 			entt::snapshot_loader loader{ registry };
 
 			loader
-				.get<entt::entity>(ar)
-				.template get<Component::Name>(ar)
-				.template get<Component::Children>(ar)
-				.template get<Component::Hierarchy>(ar)
-				.template get<Component::Transform>(ar)
-				.template get<Component::MeshRender>(ar)
-				.template get<Component::Camera>(ar)
-				.template get<Component::DirectionalLight>(ar)
-				.template get<Component::PointLight>(ar)
-				.template get<Component::Script>(ar)
-				.template get<Component::PhysicsBody>(ar)
-				.template get<Component::BoxShape>(ar)
-				.template get<Component::SphereShape>(ar);
+				.get<entt::entity>(input)
+				.template get<Component::Name>(input)
+				.template get<Component::Children>(input)
+				.template get<Component::Hierarchy>(input)
+				.template get<Component::Transform>(input)
+				.template get<Component::MeshRender>(input)
+				.template get<Component::Camera>(input)
+				.template get<Component::DirectionalLight>(input)
+				.template get<Component::PointLight>(input)
+				.template get<Component::Script>(input)
+				.template get<Component::PhysicsBody>(input)
+				.template get<Component::BoxShape>(input)
+				.template get<Component::SphereShape>(input);
 		}
 
 		static ResourceType GetStaticType()
@@ -215,8 +286,15 @@ namespace Engine
 		void AddChild(Entity::Id parent, Entity::Id child);
 		void RemoveChild(Entity::Id parent, Entity::Id child);
 
+		void Teardown();
+
 		entt::registry registry;
 
+		std::vector<entt::delegate<void()>> teardownListeners;
+
+		inline static std::atomic<uint64_t> nextGeneration{ 1 };
+		uint64_t generation{ nextGeneration++ };
+
 		bool paused = false;
 	};
 };
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Components.h"
+
+namespace Engine
+{
+	// Written ahead of the snapshot. Scenes from before the format was versioned start with their entity count
+	// instead, which entt keeps below its entity mask, so the tag can't be mistaken for one.
+	constexpr uint32_t SCENE_FORMAT_TAG = 0x454e4353;
+	// 1: MeshRender holds castShadows
+	constexpr uint32_t SCENE_FORMAT_VERSION = 1;
+
+	// Hands a scene snapshot to entt, reading components in the layout of the version the scene was saved with.
+	// For unversioned scenes the entity count was already read to tell them apart, so it's given back first.
+	template<typename Archive>
+	class SceneInputArchive
+	{
+	public:
+		SceneInputArchive(Archive& archive, uint32_t version, std::optional<uint32_t> entityCount)
+			: archive(archive), version(version), entityCount(entityCount)
+		{
+		}
+
+		template<typename... Types>
+		void operator()(Types&... values)
+		{
+			(Read(values), ...);
+		}
+
+	private:
+		template<typename Type>
+		void Read(Type& value)
+		{
+			if constexpr (std::is_same_v<Type, uint32_t>)
+			{
+				if (entityCount)
+				{
+					value = *std::exchange(entityCount, std::nullopt);
+					return;
+				}
+			}
+
+			if constexpr (requires { Component::LoadUnversioned(archive, value); })
+			{
+				if (version == 0)
+				{
+					Component::LoadUnversioned(archive, value);
+					return;
+				}
+			}
+
+			archive(value);
+		}
+
+		Archive& archive;
+		uint32_t version;
+		std::optional<uint32_t> entityCount;
+	};
+}
@@ -11,9 +11,14 @@ namespace Vulkan
     Buffer::~Buffer()
     {
         vmaDestroyBuffer(device.GetAllocator(), handle, allocation);
+
+        if (WasBound())
+        {
+            device.BumpDescriptorGeneration();
+        }
     }
 
-    void Buffer::SetData(void* data, uint32_t size, uint32_t offset) const
+    void Buffer::SetData(const void* data, uint32_t size, uint32_t offset) const
     {
         memcpy(mappedData + offset, data, size);
         Flush();
@@ -14,15 +14,17 @@ namespace Vulkan
 		Index = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 		Uniform = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 		Staging = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		Storage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		Indirect = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 	};
 
-	class Buffer : public Resource<VkBuffer>
+	class Buffer : public Resource<VkBuffer>, public DescriptorResource
 	{
 	public:
 		Buffer(const Device& device, uint32_t size);
 		~Buffer();
 
-		void SetData(void* data, uint32_t size, uint32_t offset = 0) const;
+		void SetData(const void* data, uint32_t size, uint32_t offset = 0) const;
 		void Flush() const;
 		bool IsHostVisible() const;
 
@@ -34,7 +36,7 @@ namespace Vulkan
 
 		const Device& device;
 
-		uint8_t* mappedData;
+		uint8_t* mappedData{ nullptr };
 		uint32_t size;
 
 		friend class BufferBuilder;
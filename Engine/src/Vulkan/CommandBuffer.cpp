@@ -7,6 +7,7 @@
 #include "Sampler.h"
 #include "ResourceCache.h"
 #include "Rendering/RenderFrame.h"
+#include "Rendering/TextureTable.h"
 
 namespace Vulkan
 {
@@ -37,6 +38,7 @@ namespace Vulkan
 	void CommandBuffer::Begin(BeginFlags flags)
 	{
 		pipelineState.Reset();
+		ResetBindings();
 
 		VkCommandBufferBeginInfo beginInfo{};
 		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -49,6 +51,36 @@ namespace Vulkan
 		}
 	}
 
+	void CommandBuffer::Begin(const PipelineRenderingState& inheritance)
+	{
+		pipelineState.Reset();
+		ResetBindings();
+
+		VkCommandBufferInheritanceRenderingInfo renderingInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+			.colorAttachmentCount = static_cast<uint32_t>(inheritance.colorAttachmentFormats.size()),
+			.pColorAttachmentFormats = inheritance.colorAttachmentFormats.data(),
+			.depthAttachmentFormat = inheritance.depthAttachmentFormat,
+			.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+		};
+
+		VkCommandBufferInheritanceInfo inheritanceInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+			.pNext = &renderingInfo,
+		};
+
+		VkCommandBufferBeginInfo beginInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+			.pInheritanceInfo = &inheritanceInfo,
+		};
+
+		if (vkBeginCommandBuffer(handle, &beginInfo) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to begin recording secondary command buffer!");
+		}
+	}
+
 	void CommandBuffer::End()
 	{
 		vkEndCommandBuffer(handle);
@@ -63,8 +95,7 @@ namespace Vulkan
 	{
 		vkCmdEndRendering(handle);
 
-		imageBindings.clear();
-		bufferBindings.clear();
+		ResetBindings();
 		pipelineState.Reset();
 	}
 
@@ -115,7 +146,32 @@ namespace Vulkan
 
 	void CommandBuffer::BindPipelineLayout(PipelineLayout& pipelineLayout)
 	{
+		if (pipelineState.GetPipelineLayout() == &pipelineLayout)
+		{
+			return;
+		}
+
 		pipelineState.SetPipelineLayout(pipelineLayout);
+
+		// Sets bound with another layout aren't guaranteed to stay compatible, so all of them are requested and bound again
+		boundSets.clear();
+
+		for (const auto& [set, _] : bufferBindings)
+		{
+			dirtySets.insert(set);
+		}
+
+		for (const auto& [set, _] : imageBindings)
+		{
+			dirtySets.insert(set);
+		}
+
+		if (pipelineLayout.HasTextureTable())
+		{
+			auto& textureTable = device.GetTextureTable();
+
+			BindDescriptorSet(Engine::TextureTable::SET, textureTable.GetDescriptorSet());
+		}
 	}
 
 	void CommandBuffer::Flush()
@@ -134,9 +190,13 @@ namespace Vulkan
 		vkCmdBindPipeline(handle, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.GetHandle());
 	}
 
-	void CommandBuffer::BindDescriptorSet(VkDescriptorSet descriptorSet)
+	void CommandBuffer::BindDescriptorSet(uint32_t set, VkDescriptorSet descriptorSet, std::span<const uint32_t> dynamicOffsets)
 	{
-		vkCmdBindDescriptorSets(handle, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineState.GetPipelineLayout()->GetHandle(), 0, 1, &descriptorSet, 0, nullptr);
+		vkCmdBindDescriptorSets(handle, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineState.GetPipelineLayout()->GetHandle(), set, 1, &descriptorSet, dynamicOffsets.size(), dynamicOffsets.data());
+
+		auto& bound = boundSets[set];
+		bound.handle = descriptorSet;
+		bound.dynamicOffsets.assign(dynamicOffsets.begin(), dynamicOffsets.end());
 	}
 
 	void CommandBuffer::PushConstants(VkShaderStageFlags stages, uint32_t offset, uint32_t size, void* data)
@@ -146,29 +206,79 @@ namespace Vulkan
 
 	void CommandBuffer::BindBuffer(const Buffer& buffer, uint32_t offset, uint32_t size, uint32_t set, uint32_t binding, uint32_t arrayElement)
 	{
-		bufferBindings[set][binding][arrayElement] = { buffer.GetHandle(), offset, size };
+		auto& info = bufferBindings[set][binding][arrayElement];
 
+		if (info.buffer == buffer.GetHandle() && info.offset == offset && info.range == size)
+		{
+			return;
+		}
+
+		info = { buffer.GetHandle(), offset, size };
+		dirtySets.insert(set);
+
+		buffer.MarkBound();
 	}
 
 	void CommandBuffer::BindImage(const ImageView& imageView, const Sampler& sampler, uint32_t set, uint32_t binding, uint32_t arrayElement)
 	{
-		imageBindings[set][binding][arrayElement] = { sampler.GetHandle(), imageView.GetHandle(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+		auto& info = imageBindings[set][binding][arrayElement];
+
+		if (info.sampler == sampler.GetHandle() && info.imageView == imageView.GetHandle())
+		{
+			return;
+		}
+
+		info = { sampler.GetHandle(), imageView.GetHandle(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+		dirtySets.insert(set);
+
+		imageView.MarkBound();
+		sampler.MarkBound();
 	}
 
 	void CommandBuffer::FlushDescriptorSets()
 	{
 		assert(pipelineState.GetPipelineLayout());
 
-		for (int set = 0; set < std::max(bufferBindings.size(), imageBindings.size()); set++)
+		for (auto set : dirtySets)
 		{
 			auto* layout = pipelineState.GetPipelineLayout();
 			auto& descritorSetLayout = layout->GetDescriptorSetLayout(set);
 
 			auto* frame = commandPool.GetRenderFrame();
-			auto descriptorSet = frame->RequestDescriptorSet(descritorSetLayout, bufferBindings[set], imageBindings[set]);
+			auto descriptorSet = frame->RequestDescriptorSet(descritorSetLayout, bufferBindings[set], imageBindings[set], commandPool.GetThreadIndex());
 
-			BindDescriptorSet(descriptorSet);
+			// Offsets of dynamic buffers go with the bind instead of the set, ordered by binding and array element
+			thread_local std::vector<uint32_t> dynamicOffsets;
+			dynamicOffsets.clear();
+
+			for (auto& [index, infos] : bufferBindings[set])
+			{
+				if (descritorSetLayout.IsDynamic(index))
+				{
+					for (auto& [element, info] : infos)
+					{
+						dynamicOffsets.push_back(static_cast<uint32_t>(info.offset));
+					}
+				}
+			}
+
+			if (auto it = boundSets.find(set); it != boundSets.end() && it->second.handle == descriptorSet && std::ranges::equal(it->second.dynamicOffsets, dynamicOffsets))
+			{
+				continue;
+			}
+
+			BindDescriptorSet(set, descriptorSet, dynamicOffsets);
 		}
+
+		dirtySets.clear();
+	}
+
+	void CommandBuffer::ResetBindings()
+	{
+		bufferBindings.clear();
+		imageBindings.clear();
+		dirtySets.clear();
+		boundSets.clear();
 	}
 
 	void CommandBuffer::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
@@ -185,14 +295,23 @@ namespace Vulkan
 		vkCmdDrawIndexed(handle, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 	}
 
+	void CommandBuffer::DrawIndexedIndirect(const Buffer& buffer, uint32_t offset, uint32_t drawCount)
+	{
+		Flush();
+
+		vkCmdDrawIndexedIndirect(handle, buffer.GetHandle(), offset, drawCount, sizeof(VkDrawIndexedIndirectCommand));
+	}
+
 	void CommandBuffer::Free()
 	{
 		vkFreeCommandBuffers(device.GetHandle(), commandPool.GetHandle(), 1, &handle);
 	}
 
-	void CommandBuffer::CopyBuffer(VkBuffer src, VkBuffer dst, uint32_t size)
+	void CommandBuffer::CopyBuffer(VkBuffer src, VkBuffer dst, uint32_t size, uint32_t srcOffset, uint32_t dstOffset)
 	{
 		VkBufferCopy copy{
+			.srcOffset = srcOffset,
+			.dstOffset = dstOffset,
 			.size = size
 		};
 
@@ -342,8 +461,10 @@ namespace Vulkan
 
 		auto subresourceRange = imageView.GetSubresourceRange();
 
-		VkImageMemoryBarrier barrier{};
-		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		VkImageMemoryBarrier2 barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+		barrier.srcStageMask = barrierInfo.srcStageMask;
+		barrier.dstStageMask = barrierInfo.dstStageMask;
 		barrier.srcAccessMask = barrierInfo.srcAccessMask;
 		barrier.dstAccessMask = barrierInfo.dstAccessMask;
 		barrier.oldLayout = barrierInfo.oldLayout;
@@ -353,6 +474,29 @@ namespace Vulkan
 		barrier.image = image.GetHandle();
 		barrier.subresourceRange = subresourceRange;
 
-		vkCmdPipelineBarrier(handle, barrierInfo.srcStageMask, barrierInfo.dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+		PipelineBarrier({ &barrier, 1 });
+	}
+
+	void CommandBuffer::PipelineBarrier(std::span<const VkImageMemoryBarrier2> imageBarriers, std::span<const VkBufferMemoryBarrier2> bufferBarriers)
+	{
+		if (imageBarriers.empty() && bufferBarriers.empty())
+		{
+			return;
+		}
+
+		VkDependencyInfo dependencyInfo{
+			.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+			.bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size()),
+			.pBufferMemoryBarriers = bufferBarriers.data(),
+			.imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size()),
+			.pImageMemoryBarriers = imageBarriers.data(),
+		};
+
+		vkCmdPipelineBarrier2(handle, &dependencyInfo);
+	}
+
+	void CommandBuffer::ExecuteCommands(const CommandBuffer& secondary)
+	{
+		vkCmdExecuteCommands(handle, 1, &secondary.GetHandle());
 	}
 }
@@ -30,11 +30,11 @@ namespace Vulkan
 
 	struct ImageMemoryBarrierInfo
 	{
-		VkPipelineStageFlags srcStageMask{ VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT };
-		VkPipelineStageFlags dstStageMask{ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT };
+		VkPipelineStageFlags2 srcStageMask{ VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT };
+		VkPipelineStageFlags2 dstStageMask{ VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT };
 
-		VkAccessFlags srcAccessMask{ 0 };
-		VkAccessFlags dstAccessMask{ 0 };
+		VkAccessFlags2 srcAccessMask{ 0 };
+		VkAccessFlags2 dstAccessMask{ 0 };
 
 		VkImageLayout oldLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
 		VkImageLayout newLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
@@ -62,6 +62,8 @@ namespace Vulkan
 		~CommandBuffer();
 
 		void Begin(BeginFlags flags = BeginFlags::None);
+		// Begins a secondary command buffer that continues a dynamic rendering scope with the given attachment formats
+		void Begin(const PipelineRenderingState& inheritance);
 		void End();
 
 		void BeginRendering(const VkRenderingInfo& renderingInfo);
@@ -80,26 +82,38 @@ namespace Vulkan
 		void BindPipelineLayout(PipelineLayout& pipelineLayout);
 		void BindBuffer(const Buffer& buffer, uint32_t offset, uint32_t size, uint32_t set, uint32_t binding, uint32_t arrayElement);
 		void BindImage(const ImageView& imageView, const Sampler& sampler, uint32_t set, uint32_t binding, uint32_t arrayElement);
-		void BindDescriptorSet(VkDescriptorSet descriptorSet);
+		void BindDescriptorSet(uint32_t set, VkDescriptorSet descriptorSet, std::span<const uint32_t> dynamicOffsets = {});
+		// Only sets whose bindings changed since they were last flushed are requested, and only bound if the set differs
 		void FlushDescriptorSets();
 
 		void PushConstants(VkShaderStageFlags stages, uint32_t offset, uint32_t size, void* data);
 
 		void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
 		void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+		void DrawIndexedIndirect(const Buffer& buffer, uint32_t offset, uint32_t drawCount);
 
 		void Free();
 
-		void CopyBuffer(VkBuffer src, VkBuffer dst, uint32_t size);
+		void CopyBuffer(VkBuffer src, VkBuffer dst, uint32_t size, uint32_t srcOffset = 0, uint32_t dstOffset = 0);
 		void CopyBufferToImage(const Buffer& buffer, const Image& image, const std::vector<VkBufferImageCopy>& regions);
 
 		void SetImageLayout(const Image& image, VkImageLayout oldLayout, VkImageLayout newLayout, VkImageSubresourceRange subresourceRange);
 		void GenerateMipMaps(const Image& image);
 
 		void ImageMemoryBarrier(const ImageView& imageView, const ImageMemoryBarrierInfo& barrier);
+		void PipelineBarrier(std::span<const VkImageMemoryBarrier2> imageBarriers, std::span<const VkBufferMemoryBarrier2> bufferBarriers = {});
+
+		void ExecuteCommands(const CommandBuffer& secondary);
 
 	private:
+		struct BoundSet
+		{
+			VkDescriptorSet handle{ VK_NULL_HANDLE };
+			std::vector<uint32_t> dynamicOffsets;
+		};
+
 		void Flush();
+		void ResetBindings();
 
 		Device& device;
 		CommandPool& commandPool;
@@ -107,5 +121,8 @@ namespace Vulkan
 		PipelineState pipelineState{};
 		std::map<uint32_t, BindingMap<VkDescriptorBufferInfo>> bufferBindings;
 		std::map<uint32_t, BindingMap<VkDescriptorImageInfo>> imageBindings;
+
+		std::set<uint32_t> dirtySets;
+		std::map<uint32_t, BoundSet> boundSets;
 	};
 }
@@ -7,7 +7,7 @@
 
 namespace Vulkan
 {
-	CommandPool::CommandPool(Device &device, Engine::RenderFrame* frame) : device(device), frame(frame)
+	CommandPool::CommandPool(Device &device, Engine::RenderFrame* frame, uint32_t thread) : device(device), frame(frame), thread(thread)
 	{
 		VkCommandPoolCreateInfo poolCreateInfo{};
 		poolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -23,22 +23,28 @@ namespace Vulkan
 	CommandPool::~CommandPool()
 	{
 		commandBuffers.clear();
+		secondaryCommandBuffers.clear();
 
 		vkDestroyCommandPool(device.GetHandle(), handle, nullptr);
 	}
 
-	CommandBuffer& CommandPool::RequestCommandBuffer()
+	CommandBuffer& CommandPool::RequestCommandBuffer(CommandBuffer::Level level)
 	{
-		if (activeCommandBuffersCount < commandBuffers.size())
+		auto primary = level == CommandBuffer::Level::Primary;
+
+		auto& buffers = primary ? commandBuffers : secondaryCommandBuffers;
+		auto& active = primary ? activeCommandBuffersCount : activeSecondaryCommandBuffersCount;
+
+		if (active < buffers.size())
 		{
-			return *commandBuffers[activeCommandBuffersCount++];
+			return *buffers[active++];
 		}
 
-		commandBuffers.emplace_back(std::make_unique<CommandBuffer>(device, *this));
+		buffers.emplace_back(std::make_unique<CommandBuffer>(device, *this, level));
 
-		activeCommandBuffersCount++;
+		active++;
 
-		return *commandBuffers.back();
+		return *buffers.back();
 	}
 
 	Engine::RenderFrame* CommandPool::GetRenderFrame()
@@ -46,10 +52,16 @@ namespace Vulkan
 		return frame;
 	}
 
+	uint32_t CommandPool::GetThreadIndex() const
+	{
+		return thread;
+	}
+
 	void CommandPool::Reset()
 	{
 		vkResetCommandPool(device.GetHandle(), handle, 0);
 
 		activeCommandBuffersCount = 0;
+		activeSecondaryCommandBuffersCount = 0;
 	}
 }
\ No newline at end of file
@@ -7,29 +7,35 @@ namespace Engine
 	class RenderFrame;
 }
 
+#include "CommandBuffer.h"
+
 namespace Vulkan
 {
 	class Device;
-	class CommandBuffer;
 
 	class CommandPool : public Resource<VkCommandPool>
 	{
 	public:
-		CommandPool(Device &device, Engine::RenderFrame* frame = nullptr);
+		// The thread index tells which of the frame's per-thread pools command buffers from this pool draw from
+		CommandPool(Device &device, Engine::RenderFrame* frame = nullptr, uint32_t thread = 0);
 		~CommandPool();
 
-		CommandBuffer& RequestCommandBuffer();
+		CommandBuffer& RequestCommandBuffer(CommandBuffer::Level level = CommandBuffer::Level::Primary);
 		Engine::RenderFrame* GetRenderFrame();
+		uint32_t GetThreadIndex() const;
 
 		void Reset();
 
 	private:
 		Device& device;
 		Engine::RenderFrame* frame{ nullptr };
+		uint32_t thread{ 0 };
 
 		std::vector<std::unique_ptr<CommandBuffer>> commandBuffers;
+		std::vector<std::unique_ptr<CommandBuffer>> secondaryCommandBuffers;
 
 		uint32_t activeCommandBuffersCount = 0;
+		uint32_t activeSecondaryCommandBuffersCount = 0;
 	};
 
 }
\ No newline at end of file
@@ -21,6 +21,7 @@ namespace Vulkan
 
 		VkDescriptorPoolCreateInfo createInfo = {
 			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			.flags = descriptorSetLayout.IsUpdateAfterBind() ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT : VkDescriptorPoolCreateFlags{ 0 },
 			.maxSets = size,
 			.poolSizeCount = (uint32_t)poolSizes.size(),
 			.pPoolSizes = poolSizes.data(),
@@ -4,14 +4,18 @@
 
 namespace Vulkan
 {
-	VkDescriptorType DescriptorTypeFromShaderResourceType(Engine::ShaderResourceType type)
+	VkDescriptorType DescriptorTypeFromShaderResource(const Engine::ShaderResource& resource)
 	{
-		switch (type)
+		const auto dynamic = resource.mode == Engine::ShaderResourceMode::Dynamic;
+
+		switch (resource.type)
 		{
 		case Engine::ShaderResourceType::ImageSampler:
 			return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		case Engine::ShaderResourceType::BufferUniform:
-			return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+			return dynamic ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		case Engine::ShaderResourceType::BufferStorage:
+			return dynamic ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 		default:
 			throw std::runtime_error("No conversion possible for the shader resource type.");
 		}
@@ -20,6 +24,9 @@ namespace Vulkan
 	DescriptorSetLayout::DescriptorSetLayout(const Device& device, const uint32_t set, const std::vector<Engine::ShaderResource>& setResources)
 		: device(device), set(set)
 	{
+		std::vector<VkDescriptorBindingFlags> bindingFlags;
+		VkDescriptorSetLayoutCreateFlags flags{ 0 };
+
 		for (auto& shaderResource : setResources)
 		{
 			VkShaderStageFlags stageFlags{};
@@ -36,18 +43,36 @@ namespace Vulkan
 
 			VkDescriptorSetLayoutBinding binding{
 				.binding = shaderResource.binding,
-				.descriptorType = DescriptorTypeFromShaderResourceType(shaderResource.type),
+				.descriptorType = DescriptorTypeFromShaderResource(shaderResource),
 				.descriptorCount = shaderResource.arraySize,
 				.stageFlags = stageFlags
 			};
 
 			bindings.push_back(binding);
+
+			// Bindless arrays are written while sets using them are in flight and never fully populated
+			if (shaderResource.mode == Engine::ShaderResourceMode::Bindless)
+			{
+				bindingFlags.push_back(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT);
+				flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+				updateAfterBind = true;
+			}
+			else
+			{
+				bindingFlags.push_back(0);
+			}
 		}
 
+		const VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo = {
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+			.bindingCount = static_cast<uint32_t>(bindingFlags.size()),
+			.pBindingFlags = bindingFlags.data()
+		};
+
 		const VkDescriptorSetLayoutCreateInfo createInfo = {
 			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-			.pNext = nullptr,
-			.flags = 0,
+			.pNext = flags ? &bindingFlagsCreateInfo : nullptr,
+			.flags = flags,
 			.bindingCount = static_cast<uint32_t>(bindings.size()),
 			.pBindings = bindings.data()
 		};
@@ -65,6 +90,14 @@ namespace Vulkan
 		return bindings;
 	}
 
+	bool DescriptorSetLayout::IsDynamic(const uint32_t binding) const
+	{
+		const auto* layoutBinding = GetBinding(binding);
+
+		return layoutBinding && (layoutBinding->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+			|| layoutBinding->descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+	}
+
 	const VkDescriptorSetLayoutBinding* DescriptorSetLayout::GetBinding(const uint32_t binding) const
 	{
 		for (auto& it : bindings)
@@ -78,6 +111,11 @@ namespace Vulkan
 		return nullptr;
 	}
 
+	bool DescriptorSetLayout::IsUpdateAfterBind() const
+	{
+		return updateAfterBind;
+	}
+
 	uint32_t DescriptorSetLayout::GetSet() const
 	{
 		return set;
@@ -18,6 +18,11 @@ namespace Vulkan
 		[[nodiscard]] const std::vector<VkDescriptorSetLayoutBinding>& GetBindings() const;
 
 		[[nodiscard]] const VkDescriptorSetLayoutBinding* GetBinding(uint32_t binding) const;
+		// Whether the buffer at binding takes its offset when the set is bound instead of when it is written
+		[[nodiscard]] bool IsDynamic(uint32_t binding) const;
+
+		// Whether the layout has a bindless binding, so its sets must come from an update after bind pool
+		[[nodiscard]] bool IsUpdateAfterBind() const;
 
 		[[nodiscard]] uint32_t GetSet() const;
 
@@ -25,6 +30,7 @@ namespace Vulkan
 		const Device& device;
 
 		uint32_t set;
+		bool updateAfterBind{ false };
 		std::vector<VkDescriptorSetLayoutBinding> bindings;
 	};
 };
@@ -2,8 +2,13 @@
 
 #include "CommandBuffer.h"
 
+#include "PipelineCache.h"
 #include "ResourceCache.h"
 
+#include "Rendering/GeometryBuffer.h"
+#include "Rendering/MaterialTable.h"
+#include "Rendering/TextureTable.h"
+
 namespace Vulkan
 {
 	Device::Device(const Instance& instance, const PhysicalDevice& physicalDevice) : physicalDevice(physicalDevice)
@@ -27,13 +32,31 @@ namespace Vulkan
 		}
 
 		VkPhysicalDeviceFeatures deviceFeatures{
+			.multiDrawIndirect = VK_TRUE,
+			.drawIndirectFirstInstance = VK_TRUE,
 			.samplerAnisotropy = VK_TRUE,
 		};
 
 		const std::vector<const char*> extensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME };
 
+		VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures {
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+			.shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+			.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+			.descriptorBindingUpdateUnusedWhilePending = VK_TRUE,
+			.descriptorBindingPartiallyBound = VK_TRUE,
+			.runtimeDescriptorArray = VK_TRUE,
+		};
+
+		VkPhysicalDeviceSynchronization2Features synchronization2Features {
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES,
+			.pNext = &descriptorIndexingFeatures,
+			.synchronization2 = VK_TRUE,
+		};
+
 		VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures {
 			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES,
+			.pNext = &synchronization2Features,
 			.dynamicRendering = VK_TRUE,
 		};
 
@@ -69,13 +92,21 @@ namespace Vulkan
 		}
 
 		commandPool = std::make_unique<CommandPool>(*this);
+		pipelineCache = std::make_unique<PipelineCache>(*this);
 		resourceCache = std::make_unique<ResourceCache>(*this);
+		geometryBuffer = std::make_unique<Engine::GeometryBuffer>(*this);
+		textureTable = std::make_unique<Engine::TextureTable>(*this);
+		materialTable = std::make_unique<Engine::MaterialTable>(*this);
 	}
 
 	Device::~Device()
 	{
+		materialTable.reset();
+		textureTable.reset();
+		geometryBuffer.reset();
 		commandPool.reset(); 
 		resourceCache.reset();
+		pipelineCache.reset();
 
 		vmaDestroyAllocator(allocator);
 		vkDestroyDevice(handle, nullptr);
@@ -163,4 +194,34 @@ namespace Vulkan
 	{
 		return *resourceCache;
 	}
+
+	PipelineCache& Device::GetPipelineCache() const
+	{
+		return *pipelineCache;
+	}
+
+	Engine::GeometryBuffer& Device::GetGeometryBuffer() const
+	{
+		return *geometryBuffer;
+	}
+
+	Engine::TextureTable& Device::GetTextureTable() const
+	{
+		return *textureTable;
+	}
+
+	Engine::MaterialTable& Device::GetMaterialTable() const
+	{
+		return *materialTable;
+	}
+
+	void Device::BumpDescriptorGeneration() const
+	{
+		descriptorGeneration.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint64_t Device::GetDescriptorGeneration() const
+	{
+		return descriptorGeneration.load(std::memory_order_relaxed);
+	}
 }
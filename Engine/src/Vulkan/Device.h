@@ -10,8 +10,16 @@
 #include "Buffer.h"
 #include "Image.h"
 
+namespace Engine
+{
+	class GeometryBuffer;
+	class MaterialTable;
+	class TextureTable;
+}
+
 namespace Vulkan
 {
+	class PipelineCache;
 	class ResourceCache;
 
 	class Device : public Resource<VkDevice>
@@ -40,6 +48,15 @@ namespace Vulkan
 		VkSampleCountFlagBits GetMaxSampleCount() const;
 
 		ResourceCache& GetResourceCache() const;
+		PipelineCache& GetPipelineCache() const;
+		Engine::GeometryBuffer& GetGeometryBuffer() const;
+		Engine::TextureTable& GetTextureTable() const;
+		Engine::MaterialTable& GetMaterialTable() const;
+
+		// Bumped whenever a buffer, image view or sampler that was bound for a descriptor set is destroyed. Their handles
+		// can be reused by new objects, so sets cached by handle are only trusted while the generation they were written in lasts.
+		void BumpDescriptorGeneration() const;
+		[[nodiscard]] uint64_t GetDescriptorGeneration() const;
  
 	private:
 		std::unique_ptr<CommandPool> commandPool;
@@ -51,7 +68,13 @@ namespace Vulkan
 
 		const PhysicalDevice& physicalDevice;
 
+		std::unique_ptr<PipelineCache> pipelineCache;
 		std::unique_ptr<ResourceCache> resourceCache;
+		std::unique_ptr<Engine::GeometryBuffer> geometryBuffer;
+		std::unique_ptr<Engine::TextureTable> textureTable;
+		std::unique_ptr<Engine::MaterialTable> materialTable;
+
+		mutable std::atomic<uint64_t> descriptorGeneration{ 0 };
 
 		friend class SwapchainBuilder;
 	};
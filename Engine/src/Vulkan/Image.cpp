@@ -43,8 +43,42 @@ namespace Vulkan
     {
     }
 
+    Image::Image(
+        const Device& device,
+        VmaAllocation memory,
+        VkImageUsageFlags usage,
+        VkFormat format,
+        VkExtent3D extent,
+        VkSampleCountFlagBits samples
+    ) : device(device), usage(usage), format(format), extent(extent), sampleCount(samples), mipLevels(1), arrayLayers(1), aliased(true)
+    {
+        VkImageCreateInfo createInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = format,
+            .extent = extent,
+            .mipLevels = mipLevels,
+            .arrayLayers = arrayLayers,
+            .samples = samples,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = usage,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        };
+
+        if (vmaCreateAliasingImage(device.GetAllocator(), memory, &createInfo, &handle) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create aliasing image!");
+        }
+    }
+
     Image::~Image()
     {
+        if (handle != VK_NULL_HANDLE && aliased)
+        {
+            vkDestroyImage(device.GetHandle(), handle, nullptr);
+            return;
+        }
+
         if (handle == VK_NULL_HANDLE || allocation == VK_NULL_HANDLE)
         {
             return;
@@ -22,6 +22,14 @@ namespace Vulkan
 			VkImageCreateFlags flags = 0
 		);
 		Image(const Device& device, VkImage handle, VkImageUsageFlags usage, VkFormat format, VkExtent3D extent);
+		Image(
+			const Device& device,
+			VmaAllocation memory,
+			VkImageUsageFlags usage,
+			VkFormat format,
+			VkExtent3D extent,
+			VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT
+		);
 		~Image();
 
 		VkImageUsageFlags GetUsage() const;
@@ -33,6 +41,7 @@ namespace Vulkan
 
 	private:
 		VmaAllocation allocation = VK_NULL_HANDLE;
+		bool aliased{ false };
 		VkImageUsageFlags usage;
 		VkFormat format;
 		VkExtent3D extent;
@@ -53,5 +53,10 @@ namespace Vulkan
 	ImageView::~ImageView()
 	{
         vkDestroyImageView(device.GetHandle(), handle, nullptr);
+
+        if (WasBound())
+        {
+            device.BumpDescriptorGeneration();
+        }
 	}
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Vulkan
 {
 	class Device;
 
-	class ImageView : public Resource<VkImageView>
+	class ImageView : public Resource<VkImageView>, public DescriptorResource
 	{
 	public:
 		ImageView(const Device& device, Image& image, VkImageViewType viewType = VK_IMAGE_VIEW_TYPE_2D);
@@ -1,5 +1,7 @@
 #include "Pipeline.h"
 
+#include "PipelineCache.h"
+
 #include "Rendering/Shader.h"
 
 namespace Vulkan
@@ -159,11 +161,17 @@ namespace Vulkan
 		createInfo.basePipelineIndex = -1;
 		createInfo.pNext = &pipelineRendering;
 
-		if (vkCreateGraphicsPipelines(device.GetHandle(), VK_NULL_HANDLE, 1, &createInfo, nullptr, &handle) != VK_SUCCESS)
+		auto& pipelineCache = device.GetPipelineCache();
+
+		const auto start = std::chrono::steady_clock::now();
+
+		if (vkCreateGraphicsPipelines(device.GetHandle(), pipelineCache.GetHandle(), 1, &createInfo, nullptr, &handle) != VK_SUCCESS)
 		{
 			throw std::runtime_error("failed to create graphics pipeline!");
 		}
 
+		pipelineCache.AddCreationTime(std::chrono::steady_clock::now() - start);
+
 		for (auto shaderModule : shaderModules)
 		{
 			vkDestroyShaderModule(device.GetHandle(), shaderModule, nullptr);
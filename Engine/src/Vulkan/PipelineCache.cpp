@@ -0,0 +1,132 @@
+#include "PipelineCache.h"
+
+#include "Device.h"
+
+#include "Common/FileSystem.h"
+
+namespace Vulkan
+{
+	PipelineCache::PipelineCache(const Device& device) : device(device)
+	{
+		const VkPipelineCacheCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+		};
+
+		if (vkCreatePipelineCache(device.GetHandle(), &createInfo, nullptr, &handle) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create pipeline cache!");
+		}
+	}
+
+	PipelineCache::~PipelineCache()
+	{
+		vkDestroyPipelineCache(device.GetHandle(), handle, nullptr);
+	}
+
+	bool PipelineCache::Load(const std::filesystem::path& path)
+	{
+		this->path = path;
+
+		if (!FileSystem::Exists(path))
+		{
+			return false;
+		}
+
+		const auto data = FileSystem::ReadFile(path);
+
+		if (!IsCompatible(data))
+		{
+			return false;
+		}
+
+		const VkPipelineCacheCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+			.initialDataSize = data.size(),
+			.pInitialData = data.data(),
+		};
+
+		VkPipelineCache loaded{ VK_NULL_HANDLE };
+
+		if (vkCreatePipelineCache(device.GetHandle(), &createInfo, nullptr, &loaded) != VK_SUCCESS)
+		{
+			return false;
+		}
+
+		vkMergePipelineCaches(device.GetHandle(), loaded, 1, &handle);
+		vkDestroyPipelineCache(device.GetHandle(), handle, nullptr);
+
+		handle = loaded;
+		warm = true;
+
+		return true;
+	}
+
+	void PipelineCache::Save() const
+	{
+		if (path.empty())
+		{
+			return;
+		}
+
+		size_t size{ 0 };
+		vkGetPipelineCacheData(device.GetHandle(), handle, &size, nullptr);
+
+		std::string data(size, '\0');
+
+		if (vkGetPipelineCacheData(device.GetHandle(), handle, &size, data.data()) != VK_SUCCESS)
+		{
+			return;
+		}
+
+		data.resize(size);
+
+		FileSystem::WriteFile(path, data);
+
+		const auto milliseconds = std::chrono::duration<double, std::milli>(GetCreationTime()).count();
+
+		std::cout << "pipeline cache: created " << GetCreationCount() << " pipelines in " << milliseconds << " ms with a "
+			<< (warm ? "warm" : "cold") << " cache" << std::endl;
+	}
+
+	void PipelineCache::AddCreationTime(std::chrono::nanoseconds time)
+	{
+		creationTime.fetch_add(time.count(), std::memory_order_relaxed);
+		creationCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::chrono::nanoseconds PipelineCache::GetCreationTime() const
+	{
+		return std::chrono::nanoseconds{ creationTime.load(std::memory_order_relaxed) };
+	}
+
+	uint32_t PipelineCache::GetCreationCount() const
+	{
+		return creationCount.load(std::memory_order_relaxed);
+	}
+
+	bool PipelineCache::IsWarm() const
+	{
+		return warm;
+	}
+
+	// Drivers are expected to reject foreign data themselves, but not all of them do it gracefully
+	bool PipelineCache::IsCompatible(const std::string& data) const
+	{
+		VkPipelineCacheHeaderVersionOne header{};
+
+		if (data.size() < sizeof(header))
+		{
+			return false;
+		}
+
+		std::memcpy(&header, data.data(), sizeof(header));
+
+		const auto properties = device.GetPhysicalDeviceProperties();
+
+		return header.headerSize >= sizeof(header)
+			&& header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& header.vendorID == properties.vendorID
+			&& header.deviceID == properties.deviceID
+			&& std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Resource.h"
+
+namespace Vulkan
+{
+	class Device;
+
+	// Keeps compiled pipelines between runs. The data is only reused if its header was written by the same
+	// vendor, device and driver, anything else starts from an empty cache.
+	class PipelineCache : public Resource<VkPipelineCache>
+	{
+	public:
+		explicit PipelineCache(const Device& device);
+		~PipelineCache() override;
+
+		// Returns whether the file held valid data, pipelines created before are kept in the cache either way
+		bool Load(const std::filesystem::path& path);
+		// Writes the cache to the path it was loaded from, if any
+		void Save() const;
+
+		// Accounts the time spent in pipeline creation, which is reported when the cache is saved
+		void AddCreationTime(std::chrono::nanoseconds time);
+
+		[[nodiscard]] std::chrono::nanoseconds GetCreationTime() const;
+		[[nodiscard]] uint32_t GetCreationCount() const;
+		[[nodiscard]] bool IsWarm() const;
+
+	private:
+		[[nodiscard]] bool IsCompatible(const std::string& data) const;
+
+		const Device& device;
+
+		std::filesystem::path path;
+		bool warm{ false };
+
+		std::atomic<int64_t> creationTime{ 0 };
+		std::atomic<uint32_t> creationCount{ 0 };
+	};
+}
@@ -4,6 +4,8 @@
 
 #include "Device.h"
 
+#include "Rendering/TextureTable.h"
+
 namespace Vulkan
 {
 
@@ -108,6 +110,18 @@ namespace Vulkan
 	{
 		for (const auto& [set, shaderResources] : shaderSets)
 		{
+			// Sets indexing the texture table share its layout, so the table's set can be bound with any of them
+			const auto bindless = std::ranges::any_of(shaderResources, [](auto& resource) { return resource.mode == Engine::ShaderResourceMode::Bindless; });
+
+			if (bindless)
+			{
+				assert(set == Engine::TextureTable::SET);
+
+				descriptorSetLayouts.push_back(device.GetTextureTable().GetDescriptorSetLayout());
+				textureTable = true;
+				continue;
+			}
+
 			descriptorSetLayouts.push_back(std::make_shared<DescriptorSetLayout>(
 				device,
 				set,
@@ -139,6 +153,11 @@ namespace Vulkan
 		return shaderResourceLookUp.contains(type);
 	}
 
+	bool PipelineLayout::HasTextureTable() const
+	{
+		return textureTable;
+	}
+
 	PipelineLayout::~PipelineLayout()
 	{
 		vkDestroyPipelineLayout(device.GetHandle(), handle, nullptr);
@@ -18,6 +18,8 @@ namespace Vulkan
 		[[nodiscard]] const std::vector<Engine::ShaderModule*>& GetShaders() const;
 
 		[[nodiscard]] bool HasShaderResource(Engine::ShaderResourceType type) const;
+		// Whether the shaders read textures from the device's texture table
+		[[nodiscard]] bool HasTextureTable() const;
 
 	private:
 		void PrepareSetResources();
@@ -30,6 +32,7 @@ namespace Vulkan
 		std::unordered_map<Engine::ShaderResourceType, std::vector<Engine::ShaderResource>> shaderResourceLookUp;
 
 		std::vector<std::shared_ptr<DescriptorSetLayout>> descriptorSetLayouts;
+		bool textureTable{ false };
 
 		std::vector<Engine::ShaderModule*> shaders;
 
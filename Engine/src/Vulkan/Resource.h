@@ -18,4 +18,23 @@ namespace Vulkan
 	protected:
 		THandle handle;
 	};
+
+	// Buffers, image views and samplers remember whether they were ever bound for a descriptor set. Only those can
+	// be in a cached set, so only their destruction has to invalidate the cache, not that of staging buffers.
+	class DescriptorResource
+	{
+	public:
+		void MarkBound() const
+		{
+			bound.store(true, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] bool WasBound() const
+		{
+			return bound.load(std::memory_order_relaxed);
+		}
+
+	private:
+		mutable std::atomic<bool> bound{ false };
+	};
 }
\ No newline at end of file
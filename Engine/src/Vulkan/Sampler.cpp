@@ -16,5 +16,10 @@ namespace Vulkan
 	Sampler::~Sampler()
 	{
 		vkDestroySampler(device.GetHandle(), handle, nullptr);
+
+		if (WasBound())
+		{
+			device.BumpDescriptorGeneration();
+		}
 	}
 }
\ No newline at end of file
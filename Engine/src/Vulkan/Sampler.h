@@ -5,7 +5,7 @@
 
 namespace Vulkan
 {
-	class Sampler : public Resource<VkSampler>
+	class Sampler : public Resource<VkSampler>, public DescriptorResource
 	{
 	public:
 		Sampler(const Device &device, VkSamplerCreateInfo info);
@@ -1,5 +1,7 @@
 #version 450
 
+#extension GL_EXT_nonuniform_qualifier : require
+
 precision highp float;
 precision highp sampler2DShadow;
 
@@ -20,21 +22,22 @@ layout(set = 0, binding = 0) uniform CameraUniform {
     vec3 position;
 } camera;
 
-layout(set = 0, binding = 1) uniform ModelUniform {
-	mat4 localToWorldMatrix;
-} model;
-
-#ifdef HAS_ALBEDO_TEXTURE
-layout(set = 0, binding = 2) uniform sampler2D albedoTexture;
-#endif
+struct Material
+{
+	vec4  albedoColor;
+	float metallicFactor;
+	float roughnessFactor;
+	float alphaCutoff;
+	uint  albedoTexture;
+	uint  normalTexture;
+	uint  metallicRoughnessTexture;
+};
 
-#ifdef HAS_NORMAL_TEXTURE
-layout(set = 0, binding = 3) uniform sampler2D normalTexture;
-#endif
+layout(std430, set = 0, binding = 2) readonly buffer MaterialBuffer {
+    Material materials[];
+};
 
-#ifdef HAS_METALLIC_ROUGHNESS_TEXTURE
-layout(set = 0, binding = 4) uniform sampler2D metallicRoughnessTexture;
-#endif
+layout(set = 1, binding = 0) uniform sampler2D textures[];
 
 struct Light
 {
@@ -53,13 +56,12 @@ layout(set = 0, binding = 7) uniform ShadowUniform {
     mat4 viewProjection;
 } shadow;
 
-layout(push_constant, std430) uniform PbrPushConstant
+layout(push_constant, std430) uniform MaterialPushConstant
 {
-	vec4  albedoColor;
-	float metallicFactor;
-	float roughnessFactor;
-	float alphaCutoff;
-} pbr;
+	uint index;
+} material;
+
+Material pbr;
 
 // Shadow -----------------------------------------------------------
 
@@ -176,7 +178,7 @@ float Saturate(float t)
 vec4 Albedo()
 {
 	#ifdef HAS_ALBEDO_TEXTURE
-	vec4 albedo = texture(albedoTexture, inUV);
+	vec4 albedo = texture(textures[pbr.albedoTexture], inUV);
     return vec4(pow(albedo.rgb, vec3(GAMMA)), albedo.a) * pbr.albedoColor;
 	#else
 	return pbr.albedoColor;
@@ -196,7 +198,7 @@ vec3 Normal()
 	mat3 TBN    = mat3(T, B, N);
 
 	#ifdef HAS_NORMAL_TEXTURE
-	vec3 n = texture(normalTexture, inUV).rgb;
+	vec3 n = texture(textures[pbr.normalTexture], inUV).rgb;
 	return normalize(TBN * (2.0 * n - 1.0));
 	#else
 	return normalize(TBN[2].xyz);
@@ -206,7 +208,7 @@ vec3 Normal()
 float Metallic()
 {
 	#ifdef HAS_METALLIC_ROUGHNESS_TEXTURE
-    return Saturate(texture(metallicRoughnessTexture, inUV).b) * pbr.metallicFactor;
+    return Saturate(texture(textures[pbr.metallicRoughnessTexture], inUV).b) * pbr.metallicFactor;
 	#else
 	return pbr.metallicFactor;
 	#endif
@@ -215,7 +217,7 @@ float Metallic()
 float Roughness()
 {
 	#ifdef HAS_METALLIC_ROUGHNESS_TEXTURE
-    return Saturate(texture(metallicRoughnessTexture, inUV).g) * pbr.roughnessFactor;
+    return Saturate(texture(textures[pbr.metallicRoughnessTexture], inUV).g) * pbr.roughnessFactor;
 	#else
 	return pbr.roughnessFactor;
 	#endif
@@ -223,6 +225,8 @@ float Roughness()
 
 void main()
 {
+	pbr = materials[material.index];
+
 	vec4 albedo = Albedo();
 
 	#ifdef ALPHA_MASK
@@ -0,0 +1,9 @@
+#version 450
+
+// Binding 0 is the shadow uniform of the shadow map shaders drawing after the copy in the same pass
+layout (set = 0, binding = 1) uniform sampler2D staticShadowMap;
+
+void main()
+{
+    gl_FragDepth = texelFetch(staticShadowMap, ivec2(gl_FragCoord.xy), 0).r;
+}
\ No newline at end of file
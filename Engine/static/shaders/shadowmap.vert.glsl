@@ -4,11 +4,11 @@ precision highp float;
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
+layout(location = 3) in mat4 inLocalToWorldMatrix;
 
-layout(set = 0, binding = 0) uniform ModelUniform {
-    mat4 localToWorldMatrix;
+layout(set = 0, binding = 0) uniform ShadowUniform {
     mat4 viewProjection;
-} model;
+} shadow;
 
 layout(push_constant, std430) uniform LightPushConstant
 {
@@ -35,10 +35,10 @@ vec3 ApplyShadowBias(vec3 position, vec3 normal)
 
 void main()
 {
-    vec4 position = model.localToWorldMatrix * vec4(inPosition, 1.0);
-    vec3 normal = normalize(mat3(model.localToWorldMatrix) * inNormal);
+    vec4 position = inLocalToWorldMatrix * vec4(inPosition, 1.0);
+    vec3 normal = normalize(mat3(inLocalToWorldMatrix) * inNormal);
 
     vec3 biased = ApplyShadowBias(position.xyz, normal);
 
-    gl_Position = model.viewProjection * vec4(biased, 1.0);
+    gl_Position = shadow.viewProjection * vec4(biased, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Common/FreeListAllocator.h>
+
+using namespace Engine;
+
+TEST_CASE("it should allocate aligned ranges until the space is full", "[FreeListAllocator]")
+{
+    FreeListAllocator allocator{ 64 };
+
+    REQUIRE(allocator.Allocate(10) == 0u);
+    REQUIRE(allocator.Allocate(8, 16) == 16u);
+    REQUIRE(allocator.Allocate(4) == 10u);
+    REQUIRE(allocator.Allocate(64) == std::nullopt);
+    REQUIRE(allocator.Allocate(0) == std::nullopt);
+
+    REQUIRE(allocator.GetFreeSize() == 64 - 22);
+}
+
+TEST_CASE("it should merge freed ranges with their free neighbours", "[FreeListAllocator]")
+{
+    FreeListAllocator allocator{ 30 };
+
+    auto a = allocator.Allocate(10);
+    auto b = allocator.Allocate(10);
+    auto c = allocator.Allocate(10);
+
+    REQUIRE(allocator.GetFreeRangeCount() == 0);
+
+    allocator.Free(*a, 10);
+    allocator.Free(*c, 10);
+
+    REQUIRE(allocator.GetFreeRangeCount() == 2);
+    REQUIRE(allocator.Allocate(20) == std::nullopt);
+
+    allocator.Free(*b, 10);
+
+    REQUIRE(allocator.GetFreeRangeCount() == 1);
+    REQUIRE(allocator.GetFreeSize() == 30);
+    REQUIRE(allocator.Allocate(30) == 0u);
+}
@@ -0,0 +1,44 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Common/RadixSort.h>
+
+using namespace Engine;
+
+struct KeyedItem
+{
+    uint64_t key{ 0 };
+    int id{ 0 };
+};
+
+TEST_CASE("it should sort by the full 64 bit key", "[RadixSort]")
+{
+    std::vector<KeyedItem> items;
+    std::vector<KeyedItem> scratch;
+
+    std::mt19937_64 random{ 42 };
+
+    for (int id = 0; id < 1000; id++)
+    {
+        items.push_back({ random(), id });
+    }
+
+    auto expected = items;
+    std::ranges::sort(expected, {}, &KeyedItem::key);
+
+    RadixSort(items, scratch, [](const KeyedItem& item) { return item.key; });
+
+    REQUIRE(std::ranges::equal(items, expected, {}, &KeyedItem::id, &KeyedItem::id));
+}
+
+TEST_CASE("it should keep the order of items with equal keys", "[RadixSort]")
+{
+    std::vector<KeyedItem> items{ { 3, 0 }, { 1ull << 62, 1 }, { 3, 2 }, { 0, 3 }, { 1ull << 62, 4 } };
+    std::vector<KeyedItem> scratch;
+
+    RadixSort(items, scratch, [](const KeyedItem& item) { return item.key; });
+
+    std::vector<int> ids;
+    std::ranges::transform(items, std::back_inserter(ids), &KeyedItem::id);
+
+    REQUIRE(ids == std::vector{ 3, 0, 2, 1, 4 });
+}
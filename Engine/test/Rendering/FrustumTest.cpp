@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <Rendering/Frustum.h>
+#include <Rendering/Mesh.h>
+
+using namespace Engine;
+
+AABB UnitBox(glm::vec3 center)
+{
+    return { center - glm::vec3{ 0.5f }, center + glm::vec3{ 0.5f } };
+}
+
+Frustum LookingDownNegativeZ()
+{
+    const auto projection = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f);
+    const auto view = glm::lookAt(glm::vec3{ 0.f }, glm::vec3{ 0.f, 0.f, -1.f }, glm::vec3{ 0.f, 1.f, 0.f });
+
+    return Frustum{ projection * view };
+}
+
+TEST_CASE("it should keep bounds in front of the camera", "[Frustum]")
+{
+    const auto frustum = LookingDownNegativeZ();
+
+    REQUIRE(frustum.Intersects(UnitBox({ 0.f, 0.f, -10.f })));
+    REQUIRE(frustum.Intersects(UnitBox({ 5.5f, 0.f, -10.f })));
+}
+
+TEST_CASE("it should reject bounds behind, beyond or beside the camera", "[Frustum]")
+{
+    const auto frustum = LookingDownNegativeZ();
+
+    REQUIRE_FALSE(frustum.Intersects(UnitBox({ 0.f, 0.f, 10.f })));
+    REQUIRE_FALSE(frustum.Intersects(UnitBox({ 0.f, 0.f, -200.f })));
+    REQUIRE_FALSE(frustum.Intersects(UnitBox({ 20.f, 0.f, -10.f })));
+}
+
+TEST_CASE("it should cull many bounds the same way as one at a time", "[Frustum]")
+{
+    const auto frustum = LookingDownNegativeZ();
+
+    // Six bounds cover both a full group of four and the remainder
+    const std::vector<AABB> boxes{
+        UnitBox({ 0.f, 0.f, -10.f }),
+        UnitBox({ 0.f, 0.f, 10.f }),
+        UnitBox({ 20.f, 0.f, -10.f }),
+        UnitBox({ 0.f, 3.f, -10.f }),
+        UnitBox({ 0.f, 0.f, -200.f }),
+        UnitBox({ -1.f, -1.f, -5.f }),
+    };
+
+    CullingBounds bounds;
+
+    for (const auto& box : boxes)
+    {
+        bounds.Add(box);
+    }
+
+    std::vector<uint8_t> visible;
+    frustum.Cull(bounds, visible);
+
+    REQUIRE(visible == std::vector<uint8_t>{ 1, 0, 0, 1, 0, 1 });
+
+    for (uint32_t index = 0; index < boxes.size(); index++)
+    {
+        REQUIRE(bool(visible[index]) == frustum.Intersects(boxes[index]));
+    }
+}
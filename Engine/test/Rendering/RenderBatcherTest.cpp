@@ -0,0 +1,294 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <Rendering/RenderBatcher.h>
+#include <Rendering/RenderCamera.h>
+#include <Rendering/Pass/ShadowPass.h>
+#include <Scene/Scene.h>
+
+#include <Common/ThreadPool.h>
+
+using namespace Engine;
+
+std::shared_ptr<Mesh> MakeMesh(AlphaMode alphaMode)
+{
+    auto material = std::make_shared<Material>(nullptr, nullptr, nullptr, glm::vec4{ 1.f }, 0.f, 0.f, alphaMode);
+
+    Primitive primitive;
+    primitive.SetMaterial(material);
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->AddPrimitive(std::move(primitive));
+    mesh->SetBounds({ glm::vec3{ -0.5f }, glm::vec3{ 0.5f } });
+
+    return mesh;
+}
+
+void AddLight(Scene& scene)
+{
+    auto light = scene.CreateEntity();
+    scene.AddComponent<Component::DirectionalLight>(light);
+}
+
+// A grid of entities in front of the camera, half of it out of view, cycling through the given meshes
+void FillScene(Scene& scene, const std::vector<std::shared_ptr<Mesh>>& meshes, int count)
+{
+    AddLight(scene);
+
+    for (int i = 0; i < count; i++)
+    {
+        auto entity = scene.CreateEntity();
+
+        scene.GetComponent<Component::Transform>(entity).position = {
+            static_cast<float>(i % 100) - 50.f,
+            static_cast<float>(i / 100 % 100) - 50.f,
+            -10.f - static_cast<float>(i / 10000)
+        };
+        scene.AddComponent<Component::MeshRender>(entity, meshes[i % meshes.size()]);
+    }
+
+    scene.Update();
+}
+
+bool SameBatches(const std::vector<RenderBatch>& a, const std::vector<RenderBatch>& b)
+{
+    return std::ranges::equal(a, b, [](const auto& left, const auto& right) {
+        return left.primitive == right.primitive && left.firstInstance == right.firstInstance && left.instanceCount == right.instanceCount;
+    });
+}
+
+TEST_CASE("it should only cache entities with a mesh", "[RenderBatcher]")
+{
+    RenderBatcher batcher;
+    RenderCamera camera;
+    Scene scene;
+
+    auto mesh = MakeMesh(AlphaMode::Opaque);
+
+    auto a = scene.CreateEntity();
+    auto b = scene.CreateEntity();
+    scene.CreateEntity();
+
+    scene.AddComponent<Component::MeshRender>(a, mesh);
+    scene.AddComponent<Component::MeshRender>(b, mesh);
+    scene.Update();
+
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.GetObjectCount() == 2);
+
+    scene.RemoveComponent<Component::MeshRender>(a);
+    scene.DestroyEntity(b);
+
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.GetObjectCount() == 0);
+}
+
+TEST_CASE("it should rebuild its cache when another scene is assigned to the attached one", "[RenderBatcher]")
+{
+    RenderBatcher batcher;
+    RenderCamera camera;
+    Scene scene;
+
+    auto mesh = MakeMesh(AlphaMode::Opaque);
+
+    FillScene(scene, { mesh }, 4);
+
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.GetObjectCount() == 4);
+
+    const auto generation = scene.GetGeneration();
+
+    {
+        Scene other;
+        FillScene(other, { mesh }, 2);
+
+        scene = other;
+    }
+
+    REQUIRE(scene.GetGeneration() != generation);
+    REQUIRE(batcher.GetObjectCount() == 0);
+
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.GetObjectCount() == 2);
+}
+
+TEST_CASE("it should only draw shadow casters inside the light volume", "[RenderBatcher]")
+{
+    RenderBatcher batcher;
+    RenderCamera camera;
+    Scene scene;
+
+    auto mesh = MakeMesh(AlphaMode::Opaque);
+
+    auto inside = scene.CreateEntity();
+    auto outside = scene.CreateEntity();
+    auto hidden = scene.CreateEntity();
+
+    scene.GetComponent<Component::Transform>(outside).position = { 500.f, 0.f, 0.f };
+
+    scene.AddComponent<Component::MeshRender>(inside, mesh);
+    scene.AddComponent<Component::MeshRender>(outside, mesh);
+    scene.AddComponent<Component::MeshRender>(hidden, mesh, false);
+    scene.Update();
+
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.GetShadowCasterBatches().empty());
+
+    AddLight(scene);
+    batcher.BuildBatches(scene, camera);
+
+    const auto& casters = batcher.GetShadowCasterBatches();
+
+    REQUIRE(casters.size() == 1);
+    REQUIRE(casters[0].instanceCount == 1);
+    REQUIRE(batcher.GetInstances()[casters[0].firstInstance] == scene.GetComponent<Component::LocalToWorld>(inside).value);
+
+    scene.GetComponent<Component::MeshRender>(hidden).castShadows = true;
+    scene.PatchComponent<Component::MeshRender>(hidden);
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.GetShadowCasterBatches()[0].instanceCount == 2);
+}
+
+TEST_CASE("it should only redraw static shadow casters when they change", "[RenderBatcher]")
+{
+    RenderBatcher batcher;
+    RenderCamera camera;
+    Scene scene;
+
+    batcher.SetShadowSettings({ .mode = ShadowMode::CachedStatic, .staticFrames = 2 });
+
+    auto mesh = MakeMesh(AlphaMode::Opaque);
+
+    AddLight(scene);
+
+    auto entity = scene.CreateEntity();
+    scene.AddComponent<Component::MeshRender>(entity, mesh);
+    scene.Update();
+
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.GetShadowCasterBatches().size() == 1);
+    REQUIRE(batcher.GetStaticShadowCasterBatches().empty());
+
+    batcher.BuildBatches(scene, camera);
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.HasStaticShadowChanges());
+    REQUIRE(batcher.GetShadowCasterBatches().empty());
+    REQUIRE(batcher.GetStaticShadowCasterBatches().size() == 1);
+
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(!batcher.HasStaticShadowChanges());
+    REQUIRE(batcher.GetStaticShadowCasterBatches().empty());
+
+    scene.GetComponent<Component::Transform>(entity).position = { 1.f, 0.f, 0.f };
+    scene.Update();
+    batcher.BuildBatches(scene, camera);
+
+    REQUIRE(batcher.HasStaticShadowChanges());
+    REQUIRE(batcher.GetShadowCasterBatches().size() == 1);
+    REQUIRE(batcher.GetStaticShadowCasterBatches().empty());
+}
+
+TEST_CASE("it should draw batches without uploaded geometry directly", "[RenderBatcher]")
+{
+    RenderBatcher batcher;
+    RenderCamera camera;
+    Scene scene;
+
+    FillScene(scene, { MakeMesh(AlphaMode::Opaque), MakeMesh(AlphaMode::Opaque) }, 100);
+
+    batcher.BuildBatches(scene, camera);
+
+    const auto& batches = batcher.GetOpaqueBatches();
+    const auto& draws = batcher.GetOpaqueDraws();
+
+    REQUIRE(draws.size() == batches.size());
+    REQUIRE(batcher.GetDrawCommands().empty());
+    REQUIRE(std::ranges::none_of(draws, &RenderDraw::indirect));
+}
+
+TEST_CASE("it should keep the instances of every primitive in one batch", "[RenderBatcher]")
+{
+    RenderBatcher batcher;
+    RenderCamera camera;
+    Scene scene;
+
+    std::vector<std::shared_ptr<Mesh>> meshes;
+
+    for (int i = 0; i < 256; i++)
+    {
+        meshes.push_back(MakeMesh(AlphaMode::Opaque));
+    }
+
+    FillScene(scene, meshes, 10000);
+
+    batcher.BuildBatches(scene, camera);
+
+    std::set<const Primitive*> primitives;
+
+    for (const auto& batch : batcher.GetOpaqueBatches())
+    {
+        REQUIRE(primitives.insert(batch.primitive).second);
+    }
+
+    REQUIRE(!primitives.empty());
+}
+
+TEST_CASE("it should build the same batches on a thread pool", "[RenderBatcher]")
+{
+    RenderBatcher serial;
+    RenderBatcher parallel;
+    RenderCamera camera;
+    ThreadPool threads{ 3 };
+    Scene scene;
+
+    FillScene(scene, { MakeMesh(AlphaMode::Opaque), MakeMesh(AlphaMode::Opaque), MakeMesh(AlphaMode::Blend) }, 10000);
+
+    serial.BuildBatches(scene, camera);
+    parallel.BuildBatches(scene, camera, threads);
+
+    REQUIRE(!serial.GetOpaqueBatches().empty());
+    REQUIRE(!serial.GetTransparentBatches().empty());
+    REQUIRE(!serial.GetShadowCasterBatches().empty());
+
+    REQUIRE(SameBatches(serial.GetOpaqueBatches(), parallel.GetOpaqueBatches()));
+    REQUIRE(SameBatches(serial.GetTransparentBatches(), parallel.GetTransparentBatches()));
+    REQUIRE(SameBatches(serial.GetShadowCasterBatches(), parallel.GetShadowCasterBatches()));
+    REQUIRE(serial.GetInstances() == parallel.GetInstances());
+}
+
+TEST_CASE("it should scale batch building with worker threads", "[.benchmark][RenderBatcher]")
+{
+    RenderBatcher batcher;
+    RenderCamera camera;
+    Scene scene;
+
+    FillScene(scene, { MakeMesh(AlphaMode::Opaque), MakeMesh(AlphaMode::Opaque), MakeMesh(AlphaMode::Blend) }, 100000);
+
+    BENCHMARK("build 100000 entities on the calling thread")
+    {
+        batcher.BuildBatches(scene, camera);
+
+        return batcher.GetInstances().size();
+    };
+
+    for (uint32_t workers = 1; workers <= ThreadPool::GetDefaultWorkerCount(); workers *= 2)
+    {
+        ThreadPool threads{ workers };
+
+        BENCHMARK("build 100000 entities with " + std::to_string(workers) + " workers")
+        {
+            batcher.BuildBatches(scene, camera, threads);
+
+            return batcher.GetInstances().size();
+        };
+    }
+}
@@ -1,12 +1,141 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <numeric>
+
+#include <Common/LinearAllocator.h>
+#include <Common/ThreadPool.h>
 
 #include <Rendering/RenderGraph/RenderGraph.h>
+#include <Rendering/RenderGraphAllocator.h>
+#include <Rendering/RenderGraphCommand.h>
 
 using namespace Engine;
 
+namespace
+{
+    // The replaced operator new below serves the whole binary, but only counts while a test measures a section of it
+    std::atomic<bool> countHeapAllocations{ false };
+    std::atomic<size_t> heapAllocations{ 0 };
+
+    void CountHeapAllocation()
+    {
+        if (countHeapAllocations.load(std::memory_order_relaxed))
+        {
+            heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Counts what it forwards to the heap, as upstream of an arena and as the default for pmr containers
+    class CountingResource final : public std::pmr::memory_resource
+    {
+    public:
+        size_t allocations{ 0 };
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            allocations++;
+
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+void* operator new(std::size_t size)
+{
+    CountHeapAllocation();
+
+    if (auto* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t size) noexcept
+{
+    std::free(pointer);
+}
+
+// Over-aligned requests (std::pmr::new_delete_resource uses these) keep the malloc'd pointer right before the aligned block
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    CountHeapAllocation();
+
+    const auto align = static_cast<std::size_t>(alignment);
+
+    auto* raw = static_cast<std::byte*>(std::malloc(size + align + sizeof(void*)));
+
+    if (!raw)
+    {
+        throw std::bad_alloc();
+    }
+
+    const auto address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*));
+    auto* aligned = reinterpret_cast<void**>((address + align - 1) & ~(align - 1));
+
+    aligned[-1] = raw;
+
+    return aligned;
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+    if (pointer)
+    {
+        std::free(static_cast<void**>(pointer)[-1]);
+    }
+}
+
+void operator delete(void* pointer, std::size_t size, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+class MockAllocator;
+class MockCommand;
+
+struct VersionedDesc
+{
+
+};
+
+struct VersionedAccessInfo
+{
+
+};
+
+struct VersionedResource
+{
+    using Descriptor = VersionedDesc;
+    using AccessInfo = VersionedAccessInfo;
+
+    using Allocator = MockAllocator;
+    using Command = MockCommand;
+
+    int version{ 0 };
+};
+
 struct FirstPassData
 {
-    RenderGraphResourceHandle target;
+    RenderGraphResourceHandle<RenderTexture> target;
 };
 
 struct SecondPassData
@@ -16,16 +145,16 @@ struct SecondPassData
 
 struct BackbufferData
 {
-    RenderGraphResourceHandle handle;
+    RenderGraphResourceHandle<RenderTexture> handle;
 };
 
-class FirstPass : public RenderGraphPass<FirstPassData>
+class FirstPass : public RenderGraphPass<FirstPassData, RenderGraphCommand>
 {
 
 public:
     void RecordRenderGraph(RenderGraphBuilder& builder, RenderGraphContext& context, FirstPassData& data) override
     {
-        data.target = builder.Allocate(RenderTextureDesc{});
+        data.target = builder.Allocate<RenderTexture>({});
 
         builder.Write(data.target);
 
@@ -40,7 +169,7 @@ public:
     bool rendered = false;
 };
 
-class SecondPass : public RenderGraphPass<SecondPassData>
+class SecondPass : public RenderGraphPass<SecondPassData, RenderGraphCommand>
 {
 
 public:
@@ -61,16 +190,67 @@ public:
     bool rendered = false;
 };
 
+struct OrderedPassData
+{
+
+};
+
+class OrderedPass : public RenderGraphPass<OrderedPassData, RenderGraphCommand>
+{
+
+public:
+    using Setup = std::function<void(RenderGraphBuilder&)>;
+
+    OrderedPass(std::vector<int>& order, int id, Setup setup) : order(order), id(id), setup(std::move(setup)) {}
+
+    void RecordRenderGraph(RenderGraphBuilder& builder, RenderGraphContext& context, OrderedPassData& data) override
+    {
+        setup(builder);
+    }
+
+    void Render(RenderGraphCommand& command, const OrderedPassData& data) override
+    {
+        order.push_back(id);
+    }
+
+private:
+    std::vector<int>& order;
+    int id;
+    Setup setup;
+};
+
 class MockAllocator : public RenderGraphAllocator
 {
 public:
-    virtual RenderTexture Allocate(const RenderTextureDesc& desc) override
+    RenderTexture Allocate(const RenderTextureDesc& desc) override
+    {
+        allocations += 1;
+        return {};
+    }
+
+    void Free(RenderTexture resource, const RenderTextureDesc& desc) override
+    {
+        releases += 1;
+    }
+
+    RenderBuffer Allocate(const RenderBufferDesc& desc) override
+    {
+        allocations += 1;
+        return {};
+    }
+
+    void Free(RenderBuffer resource, const RenderBufferDesc& desc) override
+    {
+        releases += 1;
+    }
+
+    VersionedResource Allocate(const VersionedDesc& desc)
     {
         allocations += 1;
         return {};
     }
 
-    virtual void Release(const RenderTextureDesc& desc, RenderTexture resource) override
+    void Free(VersionedResource resource, const VersionedDesc& desc)
     {
         releases += 1;
     }
@@ -82,15 +262,91 @@ public:
 class MockCommand : public RenderGraphCommand
 {
 public:
-    void BeforeRead(const RenderTextureDesc& desc, RenderTexture& texture) override
+    void BeforeRead(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info) override
+    {
+        pending += 1;
+    }
+
+    void BeforeWrite(const RenderTexture& texture, const RenderTextureDesc& desc, const RenderTextureAccessInfo& info, const RenderGraphWriteOps& ops) override
+    {
+        pending += 1;
+        writes.push_back(ops);
+    }
+
+    void BeforeRead(const RenderBuffer& buffer, const RenderBufferDesc& desc, const RenderBufferAccessInfo& info) override {}
+    void BeforeWrite(const RenderBuffer& buffer, const RenderBufferDesc& desc, const RenderBufferAccessInfo& info, const RenderGraphWriteOps& ops) override {}
+
+    void BeginPass() override
+    {
+        pending = 0;
+    }
+
+    void EndPass() override {}
+
+    [[nodiscard]] uint32_t GetPendingBarrierCount() const
+    {
+        return pending;
+    }
+
+    MockCommand& CreatePassCommand()
+    {
+        return *passCommands.emplace_back(std::make_unique<MockCommand>());
+    }
+
+    void SubmitPassCommands()
     {
+        for (auto& passCommand : passCommands)
+        {
+            submitted.push_back(passCommand->tag);
+        }
 
+        passCommands.clear();
     }
 
-    void BeforeWrite(const RenderTextureDesc& desc, RenderTexture& texture) override
+    void BindUniformBuffer(void* data, uint32_t size, uint32_t set, uint32_t binding) override {}
+
+    void DrawGeometry(DrawGeometrySettings settings) override {}
+    void DrawShadow(DrawShadowSettings settings) override {}
+    void Blit(std::string_view shader) override {}
+
+    void BeforeRead(const VersionedResource& resource, const VersionedDesc& desc, const VersionedAccessInfo& info) {}
+
+    void BeforeWrite(const VersionedResource& resource, const VersionedDesc& desc, const VersionedAccessInfo& info, const RenderGraphWriteOps& ops)
+    {
+        versions.push_back(resource.version);
+    }
+
+    std::vector<RenderGraphWriteOps> writes;
+    std::vector<int> versions;
+
+    std::vector<std::unique_ptr<MockCommand>> passCommands;
+    std::vector<int> submitted;
+    int tag{ -1 };
+    uint32_t pending{ 0 };
+};
+
+// Tags the command it renders with, so passes recorded on other threads can be told apart without sharing state
+class TaggedPass : public RenderGraphPass<OrderedPassData, RenderGraphCommand>
+{
+
+public:
+    using Setup = std::function<void(RenderGraphBuilder&)>;
+
+    TaggedPass(int id, Setup setup) : id(id), setup(std::move(setup)) {}
+
+    void RecordRenderGraph(RenderGraphBuilder& builder, RenderGraphContext& context, OrderedPassData& data) override
     {
+        setup(builder);
+    }
 
+    void Render(RenderGraphCommand& command, const OrderedPassData& data) override
+    {
+        static_cast<MockCommand&>(command).tag = id;
     }
+
+private:
+    int id;
+    Setup setup;
 };
 
 
@@ -102,7 +358,7 @@ TEST_CASE("it should compile and execute", "[RenderGraph]")
 
     auto& context = graph.GetContext();
     auto& backbuffer = context.Add<BackbufferData>();
-    backbuffer.handle = graph.AddRenderTexture({}, nullptr);
+    backbuffer.handle = graph.Import<RenderTexture>({}, {});
 
     FirstPass first;
     graph.AddPass(first);
@@ -119,17 +375,420 @@ TEST_CASE("it should compile and execute", "[RenderGraph]")
     REQUIRE(second.rendered);
 }
 
+TEST_CASE("it should cull passes that do not contribute to an imported resource", "[RenderGraph]")
+{
+    MockAllocator allocator;
+    MockCommand command;
+    RenderGraph graph;
+
+    std::vector<int> order;
+
+    auto backbuffer = graph.Import<RenderTexture>({}, {});
+
+    RenderGraphResourceHandle<RenderTexture> unused;
+
+    OrderedPass dead{ order, 0, [&](auto& builder) {
+        unused = builder.template Allocate<RenderTexture>({});
+        builder.Write(unused);
+    }};
+    OrderedPass alive{ order, 1, [&](auto& builder) {
+        builder.Write(backbuffer);
+    }};
+
+    graph.AddPass(dead);
+    graph.AddPass(alive);
+
+    graph.Compile();
+    graph.Execute(command, allocator);
+
+    REQUIRE(order == std::vector{ 1 });
+    REQUIRE(allocator.allocations == 0);
+    REQUIRE(allocator.releases == 0);
+}
+
+TEST_CASE("it should order passes after the passes they depend on", "[RenderGraph]")
+{
+    MockAllocator allocator;
+    MockCommand command;
+    RenderGraph graph;
+
+    std::vector<int> order;
+
+    auto backbuffer = graph.Import<RenderTexture>({}, {});
+
+    RenderGraphResourceHandle<RenderTexture> shadow;
+    RenderGraphResourceHandle<RenderTexture> color;
+
+    OrderedPass shadowPass{ order, 0, [&](auto& builder) {
+        shadow = builder.template Allocate<RenderTexture>({});
+        builder.Write(shadow);
+    }};
+    OrderedPass forwardPass{ order, 1, [&](auto& builder) {
+        color = builder.template Allocate<RenderTexture>({});
+        builder.Read(shadow);
+        builder.Write(color);
+    }};
+    OrderedPass compositionPass{ order, 2, [&](auto& builder) {
+        builder.Read(color);
+        builder.Write(backbuffer);
+    }};
+    OrderedPass overlayPass{ order, 3, [&](auto& builder) {
+        builder.Write(backbuffer);
+    }};
+
+    graph.AddPass(shadowPass);
+    graph.AddPass(forwardPass);
+    graph.AddPass(compositionPass);
+    graph.AddPass(overlayPass);
+
+    graph.Compile();
+    graph.Execute(command, allocator);
+
+    REQUIRE(order == std::vector{ 0, 1, 2, 3 });
+    REQUIRE(allocator.allocations == 2);
+    REQUIRE(allocator.releases == 2);
+}
+
+TEST_CASE("it should infer load and store ops from resource lifetimes", "[RenderGraph]")
+{
+    MockAllocator allocator;
+    MockCommand command;
+    RenderGraph graph;
+
+    std::vector<int> order;
+
+    auto backbuffer = graph.Import<RenderTexture>({}, {});
+
+    RenderGraphResourceHandle<RenderTexture> shadow;
+    RenderGraphResourceHandle<RenderTexture> color;
+    RenderGraphResourceHandle<RenderTexture> depth;
+
+    OrderedPass shadowPass{ order, 0, [&](auto& builder) {
+        shadow = builder.template Allocate<RenderTexture>({});
+        builder.Write(shadow);
+    }};
+    OrderedPass forwardPass{ order, 1, [&](auto& builder) {
+        color = builder.template Allocate<RenderTexture>({});
+        depth = builder.template Allocate<RenderTexture>({});
+        builder.Read(shadow);
+        builder.Write(color);
+        builder.Write(depth);
+    }};
+    OrderedPass compositionPass{ order, 2, [&](auto& builder) {
+        builder.Read(color);
+        builder.Write(backbuffer);
+    }};
+    OrderedPass overlayPass{ order, 3, [&](auto& builder) {
+        builder.Write(backbuffer);
+    }};
+
+    graph.AddPass(shadowPass);
+    graph.AddPass(forwardPass);
+    graph.AddPass(compositionPass);
+    graph.AddPass(overlayPass);
+
+    graph.Compile();
+    graph.Execute(command, allocator);
+
+    REQUIRE(command.writes == std::vector<RenderGraphWriteOps>{
+        { RenderGraphLoadOp::Clear, RenderGraphStoreOp::Store },
+        { RenderGraphLoadOp::Clear, RenderGraphStoreOp::Store },
+        { RenderGraphLoadOp::Clear, RenderGraphStoreOp::DontCare },
+        { RenderGraphLoadOp::Clear, RenderGraphStoreOp::Store },
+        { RenderGraphLoadOp::Load, RenderGraphStoreOp::Store },
+    });
+}
+
+TEST_CASE("it should free transients after their last use", "[RenderGraph]")
+{
+    struct CountingAllocator : MockAllocator
+    {
+        using MockAllocator::Allocate;
+        using MockAllocator::Free;
+
+        RenderTexture Allocate(const RenderTextureDesc& desc) override
+        {
+            live += 1;
+            peak = std::max(peak, live);
+            return MockAllocator::Allocate(desc);
+        }
+
+        void Free(RenderTexture resource, const RenderTextureDesc& desc) override
+        {
+            live -= 1;
+            MockAllocator::Free(resource, desc);
+        }
+
+        int live = 0;
+        int peak = 0;
+    };
+
+    CountingAllocator allocator;
+    MockCommand command;
+    RenderGraph graph;
+
+    std::vector<int> order;
+    std::vector<std::unique_ptr<OrderedPass>> passes;
+
+    auto backbuffer = graph.Import<RenderTexture>({}, {});
+
+    RenderGraphResourceHandle<RenderTexture> previous;
+
+    for (int i = 0; i < 8; i++)
+    {
+        passes.push_back(std::make_unique<OrderedPass>(order, i, [&, i](auto& builder) {
+            auto target = builder.template Allocate<RenderTexture>({});
+
+            if (i > 0)
+            {
+                builder.Read(previous);
+            }
+
+            builder.Write(target);
+            previous = target;
+        }));
+
+        graph.AddPass(*passes.back());
+    }
+
+    OrderedPass present{ order, 8, [&](auto& builder) {
+        builder.Read(previous);
+        builder.Write(backbuffer);
+    }};
+
+    graph.AddPass(present);
+
+    graph.Compile();
+    graph.Execute(command, allocator);
+
+    REQUIRE(allocator.allocations == 8);
+    REQUIRE(allocator.releases == 8);
+    REQUIRE(allocator.peak == 2);
+}
+
+TEST_CASE("it should record passes on a thread pool and submit them in schedule order", "[RenderGraph]")
+{
+    MockAllocator allocator;
+    MockCommand command;
+    RenderGraph graph;
+    ThreadPool threads{ 4 };
+
+    auto backbuffer = graph.Import<RenderTexture>({}, {});
+
+    constexpr int count = 16;
+
+    std::vector<RenderGraphResourceHandle<RenderTexture>> textures(count);
+    std::vector<std::unique_ptr<TaggedPass>> passes;
+
+    for (int id = 0; id < count; id++)
+    {
+        passes.push_back(std::make_unique<TaggedPass>(id, [&, id](auto& builder) {
+            if (id > 0)
+            {
+                builder.Read(textures[id - 1]);
+            }
+
+            if (id == count - 1)
+            {
+                builder.Write(backbuffer);
+                return;
+            }
+
+            textures[id] = builder.template Allocate<RenderTexture>({});
+            builder.Write(textures[id]);
+        }));
+    }
+
+    for (auto& pass : passes)
+    {
+        graph.AddPass(*pass);
+    }
+
+    graph.Compile();
+    graph.Execute(command, allocator, threads);
+
+    std::vector<int> expected(count);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    REQUIRE(command.submitted == expected);
+    REQUIRE(command.passCommands.empty());
+    REQUIRE(allocator.allocations == count - 1);
+    REQUIRE(allocator.releases == count - 1);
+}
+
+TEST_CASE("it should scale linearly with passes and transients", "[.benchmark][RenderGraph]")
+{
+    auto build = [](RenderGraph& graph, std::vector<std::unique_ptr<OrderedPass>>& passes, std::vector<int>& order, int count) {
+        auto backbuffer = graph.Import<RenderTexture>({}, {});
+
+        std::vector<RenderGraphResourceHandle<RenderTexture>> previous;
+
+        // Each pass reads everything the previous pass produced and writes a handful of new transients
+        for (int i = 0; i < count; i++)
+        {
+            passes.push_back(std::make_unique<OrderedPass>(order, i, [&](auto& builder) {
+                std::vector<RenderGraphResourceHandle<RenderTexture>> targets;
+
+                for (auto handle : previous)
+                {
+                    builder.Read(handle);
+                }
+
+                for (int j = 0; j < 8; j++)
+                {
+                    targets.push_back(builder.template Allocate<RenderTexture>({}));
+                    builder.Write(targets.back());
+                }
+
+                previous = std::move(targets);
+            }));
+
+            graph.AddPass(*passes.back());
+        }
+
+        passes.push_back(std::make_unique<OrderedPass>(order, count, [&](auto& builder) {
+            for (auto handle : previous)
+            {
+                builder.Read(handle);
+            }
+
+            builder.Write(backbuffer);
+        }));
+
+        graph.AddPass(*passes.back());
+    };
+
+    for (int count : { 100, 400, 1600 })
+    {
+        BENCHMARK("compile and execute " + std::to_string(count) + " passes")
+        {
+            MockAllocator allocator;
+            MockCommand command;
+            RenderGraph graph;
+
+            std::vector<int> order;
+            std::vector<std::unique_ptr<OrderedPass>> passes;
+
+            order.reserve(count + 1);
+
+            build(graph, passes, order, count);
+
+            graph.Compile();
+            graph.Execute(command, allocator);
+
+            return order.size();
+        };
+    }
+}
+
+TEST_CASE("it should execute a compiled graph again with rebound imports", "[RenderGraph]")
+{
+    MockAllocator allocator;
+    MockCommand command;
+    RenderGraph graph;
+
+    std::vector<int> order;
+
+    auto target = graph.Import<VersionedResource>({ 1 }, {});
+
+    OrderedPass pass{ order, 0, [&](auto& builder) {
+        builder.Write(target);
+    }};
+
+    graph.AddPass(pass);
+    graph.Compile();
+
+    graph.Execute(command, allocator);
+
+    graph.Rebind(target, { 2 });
+    graph.Execute(command, allocator);
+
+    REQUIRE(order == std::vector{ 0, 0 });
+    REQUIRE(command.versions == std::vector{ 1, 2 });
+}
+
+TEST_CASE("it should not touch the heap when rebuilding a graph in a warm arena", "[RenderGraph]")
+{
+    CountingResource heap;
+    LinearAllocator arena{ LinearAllocator::DEFAULT_BLOCK_SIZE, &heap };
+
+    MockAllocator allocator;
+    MockCommand command;
+
+    std::vector<int> order;
+
+    order.reserve(16);
+    command.writes.reserve(16);
+
+    RenderGraphResourceHandle<RenderTexture> backbuffer;
+    RenderGraphResourceHandle<RenderTexture> shadow;
+    RenderGraphResourceHandle<RenderTexture> color;
+
+    OrderedPass shadowPass{ order, 0, [&](auto& builder) {
+        shadow = builder.template Allocate<RenderTexture>({});
+        builder.Write(shadow);
+    }};
+    OrderedPass forwardPass{ order, 1, [&](auto& builder) {
+        color = builder.template Allocate<RenderTexture>({});
+        builder.Read(shadow);
+        builder.Write(color);
+    }};
+    OrderedPass compositionPass{ order, 2, [&](auto& builder) {
+        builder.Read(color);
+        builder.Write(backbuffer);
+    }};
+
+    auto frame = [&] {
+        arena.Reset();
+        order.clear();
+        command.writes.clear();
+
+        RenderGraph graph{ &arena };
+
+        backbuffer = graph.Import<RenderTexture>({}, {});
+
+        graph.GetContext().Add<BackbufferData>(backbuffer);
+
+        graph.AddPass(shadowPass);
+        graph.AddPass(forwardPass);
+        graph.AddPass(compositionPass);
+
+        graph.Compile();
+        graph.Execute(command, allocator);
+    };
+
+    auto* previous = std::pmr::set_default_resource(&heap);
+
+    frame();
+
+    const size_t before = heap.allocations;
+
+    heapAllocations = 0;
+    countHeapAllocations = true;
+
+    frame();
+
+    countHeapAllocations = false;
+
+    std::pmr::set_default_resource(previous);
+
+    REQUIRE(heapAllocations == 0);
+    REQUIRE(heap.allocations == before);
+    REQUIRE(order == std::vector{ 0, 1, 2 });
+    REQUIRE(arena.GetUsedBytes() > 0);
+}
+
 TEST_CASE("it should allocate a resources", "[RenderGraph::Builder]")
 {
-    std::vector<RenderGraphResourceEntry> entries;
+    RenderGraphVector<RenderGraphResource> resources;
 
-    RenderGraphBuilder builder{ entries };
+    RenderGraphBuilder builder{ resources, std::pmr::get_default_resource() };
 
-    auto first = builder.Allocate(RenderTextureDesc{});
-    auto second = builder.Allocate(RenderTextureDesc{});
+    auto first = builder.Allocate<RenderTexture>({});
+    auto second = builder.Allocate<RenderTexture>({});
 
-    REQUIRE(first == 0);
-    REQUIRE(second == 1);
+    REQUIRE(first.GetId() == 0);
+    REQUIRE(second.GetId() == 1);
 }
 
 TEST_CASE("it should save data", "[RenderGraph::Context]")
@@ -167,3 +826,68 @@ TEST_CASE("it should retrieve data", "[RenderGraph::Context]")
     REQUIRE(primitive == 2);
     REQUIRE(structure.test == 12);
 }
+
+TEST_CASE("it should describe the compiled graph in a snapshot", "[RenderGraph]")
+{
+    MockAllocator allocator;
+    MockCommand command;
+    RenderGraph graph;
+
+    std::vector<int> order;
+
+    auto backbuffer = graph.Import<RenderTexture>({}, { .width = 1280, .height = 720, .format = RenderTextureFormat::Linear }, "BackBuffer");
+
+    RenderGraphResourceHandle<RenderTexture> unused;
+    RenderGraphResourceHandle<RenderTexture> color;
+
+    OrderedPass dead{ order, 0, [&](auto& builder) {
+        unused = builder.template Allocate<RenderTexture>({}, "Unused");
+        builder.Write(unused);
+    }};
+    OrderedPass forward{ order, 1, [&](auto& builder) {
+        color = builder.template Allocate<RenderTexture>({ .width = 1280, .height = 720, .format = RenderTextureFormat::HDR }, "Color");
+        builder.Write(color);
+    }};
+    OrderedPass composition{ order, 2, [&](auto& builder) {
+        builder.Read(color);
+        builder.Write(backbuffer);
+    }};
+
+    graph.AddPass(dead, "Dead");
+    graph.AddPass(forward, "Forward");
+    graph.AddPass(composition);
+
+    graph.Compile();
+    graph.Execute(command, allocator);
+
+    const auto snapshot = graph.GetSnapshot();
+
+    REQUIRE(snapshot.passes.size() == 3);
+    REQUIRE(snapshot.resources.size() == 3);
+
+    REQUIRE(snapshot.passes[0].name == "Dead");
+    REQUIRE(snapshot.passes[0].IsCulled());
+    REQUIRE(snapshot.passes[1].order == 0);
+    REQUIRE(snapshot.passes[2].name == "Pass 2");
+    REQUIRE(snapshot.passes[2].order == 1);
+    REQUIRE(snapshot.passes[2].dependencies == std::vector<uint32_t>{ 1 });
+    REQUIRE(snapshot.passes[2].barriers == 2);
+
+    REQUIRE(snapshot.resources[0].imported);
+    REQUIRE(snapshot.resources[0].description == "1280x720 Linear");
+    REQUIRE(snapshot.resources[1].first == RenderGraphSnapshot::none);
+    REQUIRE(snapshot.resources[2].first == 0);
+    REQUIRE(snapshot.resources[2].last == 1);
+
+    std::ostringstream dot;
+    WriteDot(snapshot, dot);
+
+    REQUIRE(dot.str().find("pass1 -> resource2 [label=\"Clear/Store\"]") != std::string::npos);
+    REQUIRE(dot.str().find("resource2 -> pass2") != std::string::npos);
+
+    std::ostringstream json;
+    WriteJson(snapshot, json);
+
+    REQUIRE(json.str().find("\"name\": \"Dead\", \"order\": null, \"culled\": true") != std::string::npos);
+    REQUIRE(json.str().find("\"name\": \"Color\", \"description\": \"1280x720 HDR\"") != std::string::npos);
+}
@@ -1,5 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <sstream>
+
+#include <cereal/archives/portable_binary.hpp>
+
 #include "Scene/Scene.h"
 
 #include "Fixture/Components.h"
@@ -138,3 +142,143 @@ TEST_CASE("it should unset parent/child relationships", "[Scene]")
 
     REQUIRE(!scene.HasComponent<Component::Children>(parent));
 }
+
+struct UpdateListener
+{
+    std::vector<Entity::Id> updated;
+
+    void OnUpdate(Entity::Id entity)
+    {
+        updated.push_back(entity);
+    }
+};
+
+TEST_CASE("it should only signal local to world changes", "[Scene]")
+{
+    Scene scene;
+    UpdateListener listener;
+
+    auto moving = scene.CreateEntity();
+    auto still = scene.CreateEntity();
+
+    scene.GetComponent<Component::Transform>(moving).position = { 1.f, 0.f, 0.f };
+
+    scene.OnComponentUpdated<Component::LocalToWorld, &UpdateListener::OnUpdate>(&listener);
+
+    scene.Update();
+
+    REQUIRE(listener.updated == std::vector<Entity::Id>{ moving });
+
+    listener.updated.clear();
+    scene.Update();
+
+    REQUIRE(listener.updated.empty());
+
+    scene.DisconnectComponentEvents<Component::LocalToWorld>(&listener);
+    scene.GetComponent<Component::Transform>(still).position = { 0.f, 1.f, 0.f };
+    scene.Update();
+
+    REQUIRE(listener.updated.empty());
+}
+
+// Writes a snapshot the way scenes were saved before their format was versioned, when MeshRender only held its mesh
+class UnversionedOutputArchive
+{
+public:
+    explicit UnversionedOutputArchive(cereal::PortableBinaryOutputArchive& archive) : archive(archive)
+    {
+    }
+
+    template<typename... Types>
+    void operator()(const Types&... values)
+    {
+        (Write(values), ...);
+    }
+
+private:
+    template<typename Type>
+    void Write(const Type& value)
+    {
+        if constexpr (std::is_same_v<Type, Component::MeshRender>)
+        {
+            archive(value.mesh);
+        }
+        else
+        {
+            archive(value);
+        }
+    }
+
+    cereal::PortableBinaryOutputArchive& archive;
+};
+
+TEST_CASE("it should load scenes saved before the format was versioned", "[Scene]")
+{
+    std::stringstream stream;
+
+    {
+        entt::registry registry;
+
+        auto entity = registry.create();
+        registry.emplace<Component::MeshRender>(entity);
+        registry.emplace<Component::PointLight>(entity, glm::vec3{ 0.5f }, 4.f);
+
+        cereal::PortableBinaryOutputArchive output{ stream };
+        UnversionedOutputArchive archive{ output };
+
+        entt::snapshot{ registry }
+            .get<entt::entity>(archive)
+            .get<Component::Name>(archive)
+            .get<Component::Children>(archive)
+            .get<Component::Hierarchy>(archive)
+            .get<Component::Transform>(archive)
+            .get<Component::MeshRender>(archive)
+            .get<Component::Camera>(archive)
+            .get<Component::DirectionalLight>(archive)
+            .get<Component::PointLight>(archive)
+            .get<Component::Script>(archive)
+            .get<Component::PhysicsBody>(archive)
+            .get<Component::BoxShape>(archive)
+            .get<Component::SphereShape>(archive);
+    }
+
+    Scene scene;
+
+    cereal::PortableBinaryInputArchive input{ stream };
+    scene.Load(input);
+
+    auto query = scene.Query<Component::MeshRender, Component::PointLight>();
+
+    REQUIRE(std::distance(query.begin(), query.end()) == 1);
+
+    const auto entity = *query.begin();
+
+    REQUIRE(scene.GetComponent<Component::MeshRender>(entity).castShadows);
+    REQUIRE(scene.GetComponent<Component::PointLight>(entity).color == glm::vec3{ 0.5f });
+    REQUIRE(scene.GetComponent<Component::PointLight>(entity).range == 4.f);
+}
+
+TEST_CASE("it should keep whether meshes cast shadows when saved and loaded", "[Scene]")
+{
+    std::stringstream stream;
+
+    {
+        Scene scene;
+
+        auto entity = scene.CreateEntity();
+        scene.AddComponent<Component::MeshRender>(entity, nullptr, false);
+
+        cereal::PortableBinaryOutputArchive output{ stream };
+        scene.Save(output);
+    }
+
+    Scene scene;
+
+    cereal::PortableBinaryInputArchive input{ stream };
+    scene.Load(input);
+
+    auto query = scene.Query<Component::MeshRender>();
+
+    REQUIRE(std::distance(query.begin(), query.end()) == 1);
+    REQUIRE(!scene.GetComponent<Component::MeshRender>(*query.begin()).castShadows);
+}